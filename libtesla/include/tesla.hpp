@@ -43,7 +43,11 @@
 
 #include <ultra.hpp>
 #include <switch.h>
+#if defined(__ARM_NEON)
 #include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h> // Host builds (headless mode) use the SSE2 blend kernels
+#endif
 
 #include <strings.h>
 #include <math.h>
@@ -57,6 +61,9 @@
 #include <type_traits>
 #include <mutex>
 #include <shared_mutex>
+#include <unordered_set>
+#include <thread>
+#include <condition_variable>
 #include <memory>
 //#include <chrono>
 #include <list>
@@ -493,6 +500,7 @@ namespace tsl {
         // Set Ultrahand Globals
         ult::useSwipeToOpen = (ult::parseValueFromIniSection(ult::ULTRAHAND_CONFIG_INI_PATH, ult::ULTRAHAND_PROJECT_NAME, "swipe_to_open") == ult::TRUE_STR);
         ult::useOpaqueScreenshots = (ult::parseValueFromIniSection(ult::ULTRAHAND_CONFIG_INI_PATH, ult::ULTRAHAND_PROJECT_NAME, "opaque_screenshots") == ult::TRUE_STR);
+        ult::useWallpaperDithering = (ult::parseValueFromIniSection(ult::ULTRAHAND_CONFIG_INI_PATH, ult::ULTRAHAND_PROJECT_NAME, "dither_wallpaper") == ult::TRUE_STR);
 
         std::string langFile = ult::LANG_PATH+defaultLang+".json";
         if (ult::isFileOrDirectory(langFile))
@@ -527,6 +535,9 @@ namespace tsl {
     
     class Overlay;
     namespace elm { class Element; }
+    #if RENDER_BENCHMARK_DIRECTIVE
+    namespace bench { class RenderBenchmark; }
+    #endif
     
     namespace impl {
         
@@ -870,6 +881,533 @@ namespace tsl {
     
 
 
+    #if FRAME_PROFILER_DIRECTIVE
+    /**
+     * @brief Frame timing broken down by render phase, with rolling percentiles
+     * @note Phases are timed with TSL_PROFILE_PHASE scopes on the render thread and summed per frame. A phase
+     *       nested in itself (drawString measuring before recording) counts once; phases nested in others (text
+     *       inside draw) count in both. Only the last WindowFrames frames are kept, so a frame costs a few tick
+     *       reads and stores. Percentiles are computed when the HUD or an export asks for them.
+     */
+    namespace profiler {
+        
+        enum class Phase : u8 {
+            StartFrame,     ///< Renderer::startFrame
+            Update,         ///< Gui::update
+            Draw,           ///< Top level element draw (includes background and text)
+            Background,     ///< Background fill and wallpaper
+            Text,           ///< drawString
+            Flush,          ///< Display list rasterization
+            Present,        ///< Linear back buffer to framebuffer
+            VSync,          ///< Waiting for vsync
+            EndFrame,       ///< Renderer::endFrame (includes flush and vsync)
+            Frame,          ///< Whole frame
+            Count
+        };
+        
+        inline constexpr const char* PhaseNames[] = {
+            "start", "update", "draw", "background", "text", "flush", "present", "vsync", "end", "frame"
+        };
+        
+        static constexpr u32 PhaseCount = static_cast<u32>(Phase::Count);
+        static constexpr u32 WindowFrames = 256;
+        
+        /**
+         * @brief Percentiles of one phase over the window, in microseconds
+         */
+        struct PhaseStats {
+            u32 p50 = 0, p95 = 0, p99 = 0, max = 0;
+        };
+        
+        inline thread_local bool s_renderThread = false;
+        inline u64 s_frameStart = 0;
+        inline u64 s_phaseTicks[PhaseCount] = {};
+        inline u32 s_phaseDepth[PhaseCount] = {};
+        inline u32 s_samples[PhaseCount][WindowFrames] = {};
+        inline u32 s_frameCount = 0;
+        inline bool s_hudVisible = false;
+        
+        /**
+         * @brief Times the enclosing scope as part of a phase
+         */
+        class ScopedPhase {
+        public:
+            inline ScopedPhase(const Phase phase) : m_index(static_cast<u32>(phase)), m_active(s_renderThread) {
+                if (this->m_active && s_phaseDepth[this->m_index]++ == 0)
+                    this->m_start = armGetSystemTick();
+            }
+            
+            inline ~ScopedPhase() {
+                if (this->m_active && --s_phaseDepth[this->m_index] == 0)
+                    s_phaseTicks[this->m_index] += armGetSystemTick() - this->m_start;
+            }
+            
+            ScopedPhase(const ScopedPhase&) = delete;
+            ScopedPhase& operator=(const ScopedPhase&) = delete;
+            
+        private:
+            u32 m_index;
+            bool m_active;
+            u64 m_start = 0;
+        };
+        
+        /**
+         * @brief Marks the start of a frame, called from the render thread
+         */
+        inline void beginFrame() {
+            s_renderThread = true;
+            s_frameStart = armGetSystemTick();
+        }
+        
+        /**
+         * @brief Commits the frame's phase times to the window
+         */
+        inline void endFrame() {
+            s_phaseTicks[static_cast<u32>(Phase::Frame)] = armGetSystemTick() - s_frameStart;
+            
+            const u32 slot = s_frameCount % WindowFrames;
+            for (u32 i = 0; i < PhaseCount; ++i) {
+                s_samples[i][slot] = static_cast<u32>(std::min<u64>(armTicksToNs(s_phaseTicks[i]) / 1000, UINT32_MAX));
+                s_phaseTicks[i] = 0;
+            }
+            ++s_frameCount;
+        }
+        
+        /**
+         * @brief Number of frames currently in the window
+         */
+        inline u32 getSampleCount() {
+            return std::min(s_frameCount, WindowFrames);
+        }
+        
+        /**
+         * @brief Computes the percentiles of a phase over the window
+         */
+        inline PhaseStats getStats(const Phase phase) {
+            PhaseStats stats;
+            const u32 count = getSampleCount();
+            if (count == 0)
+                return stats;
+            
+            u32 sorted[WindowFrames];
+            std::copy_n(s_samples[static_cast<u32>(phase)], count, sorted);
+            std::sort(sorted, sorted + count);
+            
+            auto percentile = [&](u32 p) { return sorted[std::min(count - 1, (count * p + 99) / 100 - 1)]; };
+            stats.p50 = percentile(50);
+            stats.p95 = percentile(95);
+            stats.p99 = percentile(99);
+            stats.max = sorted[count - 1];
+            return stats;
+        }
+        
+        /**
+         * @brief Shows or hides the on-screen timing HUD
+         */
+        inline void setHudVisible(const bool visible) {
+            s_hudVisible = visible;
+        }
+        
+        inline bool isHudVisible() {
+            return s_hudVisible;
+        }
+        
+        /**
+         * @brief Writes one line per phase with its percentiles to the log
+         */
+        inline void logSummary() {
+            char line[128];
+            snprintf(line, sizeof(line), "Frame profile over %u frames (us, p50/p95/p99/max):", getSampleCount());
+            ult::logMessage(line);
+            for (u32 i = 0; i < PhaseCount; ++i) {
+                const PhaseStats stats = getStats(static_cast<Phase>(i));
+                snprintf(line, sizeof(line), "  %-10s %6u %6u %6u %6u", PhaseNames[i], stats.p50, stats.p95, stats.p99, stats.max);
+                ult::logMessage(line);
+            }
+        }
+        
+        /**
+         * @brief Writes the per-frame phase times in the window as CSV, oldest frame first
+         *
+         * @param path Output path
+         * @return true on success
+         */
+        inline bool writeTrace(const std::string& path) {
+            FILE* file = fopen(path.c_str(), "w");
+            if (!file)
+                return false;
+            
+            fputs("frame", file);
+            for (u32 i = 0; i < PhaseCount; ++i)
+                fprintf(file, ",%s_us", PhaseNames[i]);
+            fputc('\n', file);
+            
+            const u32 count = getSampleCount();
+            const u32 first = s_frameCount - count;
+            for (u32 frame = first; frame < s_frameCount; ++frame) {
+                fprintf(file, "%u", frame);
+                for (u32 i = 0; i < PhaseCount; ++i)
+                    fprintf(file, ",%u", s_samples[i][frame % WindowFrames]);
+                fputc('\n', file);
+            }
+            
+            const bool written = !ferror(file);
+            fclose(file);
+            return written;
+        }
+    }
+    
+    #define TSL_PROFILE_PHASE(phase) const tsl::profiler::ScopedPhase tslProfilePhase(tsl::profiler::Phase::phase)
+    #else
+    #define TSL_PROFILE_PHASE(phase)
+    #endif
+    
+    
+    /**
+     * @brief Decides when tsl::loop may stop rendering at full rate
+     * @note A frame is active when it had input, a fade, a running interpreter (throbber and progress) or frames
+     *       asked for through requestFrames() by animating elements. After IdleFrameThreshold inactive frames the
+     *       loop waits up to the idle refresh interval before the next frame; input and requestFrames() end the
+     *       wait early. Ambient animations such as the highlight pulse call requestAnimationInterval() every frame
+     *       they are visible and keep a smooth, lower rate while idle.
+     */
+    namespace governor {
+        
+        static constexpr u32 IdleFrameThreshold = 30;
+        
+        // Idle frame interval for ambient animations, about 30 fps
+        static constexpr u64 AmbientAnimationInterval = 33'333'333ULL;
+        
+    #if IS_STATUS_MONITOR_DIRECTIVE
+        inline std::atomic<bool> s_enabled{ false };
+    #else
+        inline std::atomic<bool> s_enabled{ true };
+    #endif
+        inline std::atomic<bool> s_idle{ false };
+        inline std::atomic<u32> s_requestedFrames{ 0 };
+        inline std::atomic<u64> s_idleRefreshInterval{ 100'000'000ULL };
+        inline std::atomic<u64> s_animationInterval{ UINT64_MAX };
+        inline std::atomic<Event*> s_wakeEvent{ nullptr };
+        inline u32 s_inactiveFrames = 0;
+        
+        /**
+         * @brief Enables or disables idle throttling
+         */
+        inline void setEnabled(const bool enabled) {
+            s_enabled.store(enabled, std::memory_order_relaxed);
+        }
+        
+        inline bool isEnabled() {
+            return s_enabled.load(std::memory_order_relaxed);
+        }
+        
+        /**
+         * @brief Sets the longest wait between frames while idle
+         *
+         * @param ns Interval in nanoseconds, UINT64_MAX to only redraw on input and requests
+         */
+        inline void setIdleRefreshInterval(const u64 ns) {
+            s_idleRefreshInterval.store(ns, std::memory_order_relaxed);
+        }
+        
+        inline u64 getIdleRefreshInterval() {
+            return s_idleRefreshInterval.load(std::memory_order_relaxed);
+        }
+        
+        /**
+         * @brief Whether the loop is currently throttled
+         */
+        inline bool isIdle() {
+            return s_idle.load(std::memory_order_acquire);
+        }
+        
+        /**
+         * @brief Ends an idle wait early, safe to call from any thread
+         */
+        inline void wake() {
+            Event* const event = s_wakeEvent.load(std::memory_order_acquire);
+            if (event && s_idle.load(std::memory_order_acquire))
+                eventFire(event);
+        }
+        
+        /**
+         * @brief Keeps the loop at full rate for the next frames, safe to call from any thread
+         *
+         * @param count Number of frames
+         */
+        inline void requestFrames(const u32 count = 1) {
+            u32 current = s_requestedFrames.load(std::memory_order_relaxed);
+            while (current < count && !s_requestedFrames.compare_exchange_weak(current, count, std::memory_order_relaxed));
+            wake();
+        }
+        
+        /**
+         * @brief Caps the idle wait after the current frame, for animations that don't need the full rate
+         *
+         * @param ns Longest wait in nanoseconds
+         */
+        inline void requestAnimationInterval(const u64 ns = AmbientAnimationInterval) {
+            u64 current = s_animationInterval.load(std::memory_order_relaxed);
+            while (ns < current && !s_animationInterval.compare_exchange_weak(current, ns, std::memory_order_relaxed));
+        }
+        
+        /**
+         * @brief Accounts for a finished frame, called by tsl::loop
+         *
+         * @param active Whether the frame had input or animation
+         * @return How long the loop may wait for a wake-up before the next frame, 0 for not at all
+         */
+        inline u64 frameFinished(bool active) {
+            const u64 animationInterval = s_animationInterval.exchange(UINT64_MAX, std::memory_order_relaxed);
+            if (s_requestedFrames.load(std::memory_order_relaxed) > 0) {
+                s_requestedFrames.fetch_sub(1, std::memory_order_relaxed);
+                active = true;
+            }
+            
+            if (active || !isEnabled()) {
+                s_inactiveFrames = 0;
+                s_idle.store(false, std::memory_order_release);
+                return 0;
+            }
+            if (s_inactiveFrames < IdleFrameThreshold) {
+                ++s_inactiveFrames;
+                return 0;
+            }
+            
+            s_idle.store(true, std::memory_order_release);
+            
+            // A request that came in before the idle flag was visible didn't fire the wake event
+            if (s_requestedFrames.load(std::memory_order_relaxed) > 0)
+                return 0;
+            
+            u64 interval = std::min(getIdleRefreshInterval(), animationInterval);
+        #if USING_WIDGET_DIRECTIVE
+            // The clock widget changes on every wall clock second
+            timespec now;
+            clock_gettime(CLOCK_REALTIME, &now);
+            interval = std::min<u64>(interval, 1'000'000'000ULL - now.tv_nsec + 1'000'000ULL);
+        #endif
+            return interval;
+        }
+    }
+    
+    
+#if USING_WIDGET_DIRECTIVE
+    /**
+     * @brief Samples the widget sensors on a background thread
+     * @note Reads go through a SensorProvider, the hardware one by default (TMP451 over I2C, psm for the battery).
+     *       Hosts without the hardware install their own. Every change in the readings bumps the generation and
+     *       asks the governor for a frame, so an idle overlay shows new values without polling.
+     */
+    namespace widget {
+        
+        /**
+         * @brief One sample of the widget sensors, 0 for sensors that are disabled or failed to read
+         */
+        struct SensorReadings {
+            float socTemperature = 0;
+            float pcbTemperature = 0;
+            u32 batteryCharge = 0;
+            bool isCharging = false;
+            
+            bool operator==(const SensorReadings& other) const {
+                return socTemperature == other.socTemperature && pcbTemperature == other.pcbTemperature &&
+                       batteryCharge == other.batteryCharge && isCharging == other.isCharging;
+            }
+        };
+        
+        /**
+         * @brief Source of sensor values, called from the sampling thread only
+         */
+        class SensorProvider {
+        public:
+            virtual ~SensorProvider() = default;
+            
+            virtual bool readSocTemperature(float& temperature) = 0;
+            virtual bool readPcbTemperature(float& temperature) = 0;
+            virtual bool readBattery(u32& charge, bool& charging) = 0;
+        };
+        
+        /**
+         * @brief Reads the console's sensors
+         */
+        class HardwareSensorProvider : public SensorProvider {
+        public:
+            bool readSocTemperature(float& temperature) override {
+                return R_SUCCEEDED(ult::ReadSocTemperature(&temperature));
+            }
+            
+            bool readPcbTemperature(float& temperature) override {
+                return R_SUCCEEDED(ult::ReadPcbTemperature(&temperature));
+            }
+            
+            bool readBattery(u32& charge, bool& charging) override {
+                return ult::powerGetDetails(&charge, &charging);
+            }
+        };
+        
+        enum Sensor : u32 {
+            SocTemperature = 1 << 0,
+            PcbTemperature = 1 << 1,
+            Battery        = 1 << 2,
+        };
+        
+        inline std::mutex s_mutex;
+        inline std::condition_variable s_wake;
+        inline std::thread s_thread;
+        inline bool s_stopping = false;
+        inline bool s_sampleRequested = false;
+        inline std::shared_ptr<SensorProvider> s_provider;
+        inline SensorReadings s_readings;
+        inline std::atomic<u32> s_generation{ 0 };
+        inline std::atomic<u32> s_sensors{ SocTemperature | PcbTemperature | Battery };
+        inline std::atomic<u64> s_samplingInterval{ 1'000'000'000ULL };
+        
+        /**
+         * @brief Reads every enabled sensor once and publishes the result if it changed
+         */
+        inline void sample() {
+            std::shared_ptr<SensorProvider> provider;
+            {
+                std::lock_guard<std::mutex> lock(s_mutex);
+                provider = s_provider;
+            }
+            if (!provider)
+                return;
+            
+            const u32 sensors = s_sensors.load(std::memory_order_relaxed);
+            SensorReadings readings;
+            if ((sensors & SocTemperature) && !provider->readSocTemperature(readings.socTemperature))
+                readings.socTemperature = 0;
+            if ((sensors & PcbTemperature) && !provider->readPcbTemperature(readings.pcbTemperature))
+                readings.pcbTemperature = 0;
+            if (sensors & Battery) {
+                if (provider->readBattery(readings.batteryCharge, readings.isCharging)) {
+                    readings.batteryCharge = std::min(readings.batteryCharge, 100U);
+                } else {
+                    readings.batteryCharge = 0;
+                    readings.isCharging = false;
+                }
+            }
+            
+            {
+                std::lock_guard<std::mutex> lock(s_mutex);
+                if (readings == s_readings)
+                    return;
+                s_readings = readings;
+                s_generation.fetch_add(1, std::memory_order_release);
+            }
+            governor::requestFrames();
+        }
+        
+        /**
+         * @brief Replaces the sensor source, takes effect with the next sample
+         */
+        inline void setProvider(std::shared_ptr<SensorProvider> provider) {
+            {
+                std::lock_guard<std::mutex> lock(s_mutex);
+                s_provider = std::move(provider);
+                s_sampleRequested = true;
+            }
+            s_wake.notify_one();
+        }
+        
+        /**
+         * @brief Sets the time between samples
+         *
+         * @param ns Interval in nanoseconds
+         */
+        inline void setSamplingInterval(const u64 ns) {
+            s_samplingInterval.store(ns, std::memory_order_relaxed);
+        }
+        
+        /**
+         * @brief Selects the sensors to sample, a change is sampled right away
+         *
+         * @param sensors Combination of Sensor flags
+         */
+        inline void setSensors(const u32 sensors) {
+            if (s_sensors.exchange(sensors, std::memory_order_relaxed) == sensors)
+                return;
+            {
+                std::lock_guard<std::mutex> lock(s_mutex);
+                s_sampleRequested = true;
+            }
+            s_wake.notify_one();
+        }
+        
+        /**
+         * @brief Sensors the widget shows with the current hide settings
+         *
+         * @return Combination of Sensor flags
+         */
+        inline u32 getShownSensors() {
+            return (ult::hideSOCTemp ? 0 : SocTemperature) | (ult::hidePCBTemp ? 0 : PcbTemperature) | (ult::hideBattery ? 0 : Battery);
+        }
+        
+        /**
+         * @brief Starts the sampling thread, which takes its first sample right away; does nothing when it already runs
+         */
+        inline void startSampling() {
+            std::lock_guard<std::mutex> lock(s_mutex);
+            if (s_thread.joinable())
+                return;
+            if (!s_provider)
+                s_provider = std::make_shared<HardwareSensorProvider>();
+            s_stopping = false;
+            s_sampleRequested = true;
+            
+            s_thread = std::thread([] {
+                std::unique_lock<std::mutex> lock(s_mutex);
+                while (!s_stopping) {
+                    s_wake.wait_for(lock, std::chrono::nanoseconds(s_samplingInterval.load(std::memory_order_relaxed)),
+                                    [] { return s_stopping || s_sampleRequested; });
+                    if (s_stopping)
+                        break;
+                    s_sampleRequested = false;
+                    
+                    lock.unlock();
+                    sample();
+                    lock.lock();
+                }
+            });
+        }
+        
+        /**
+         * @brief Stops the sampling thread, must run before the sensor services are closed
+         */
+        inline void stopSampling() {
+            {
+                std::lock_guard<std::mutex> lock(s_mutex);
+                if (!s_thread.joinable())
+                    return;
+                s_stopping = true;
+            }
+            s_wake.notify_one();
+            s_thread.join();
+        }
+        
+        /**
+         * @brief Copies the latest readings
+         *
+         * @return Generation of the readings, changes whenever they do
+         */
+        inline u32 getReadings(SensorReadings& readings) {
+            std::lock_guard<std::mutex> lock(s_mutex);
+            readings = s_readings;
+            return s_generation.load(std::memory_order_relaxed);
+        }
+        
+        /**
+         * @brief Generation of the latest readings, cheap enough to poll every frame
+         */
+        inline u32 getGeneration() {
+            return s_generation.load(std::memory_order_acquire);
+        }
+    }
+#endif
+    
+    
     // Renderer
     
     namespace gfx {
@@ -881,11 +1419,81 @@ namespace tsl {
             u32 x, y, w, h;
         };
         
+        /**
+         * @brief Half-open drawable rectangle, resolved once per draw from the framebuffer and scissor
+         */
+        struct ClipRect {
+            s32 x0, y0, x1, y1;
+        };
+        
 
         // Forward declarations
         class Renderer;
         
 
+        /**
+         * @brief Run-length description of a 4-bit alpha bitmap
+         * @note Each row is stored as a list of runs; transparent pixels between runs are never visited.
+         *       Opaque runs are filled with the solid color, blended runs read per-pixel alpha from the source.
+         */
+        struct AlphaRuns {
+            struct Run {
+                u16 start;   ///< First x of the run within its row
+                u16 length;  ///< Pixel count
+                bool opaque; ///< Every pixel has alpha 0xF
+            };
+            
+            std::vector<u32> rowStart;  ///< Index of each row's first run, height + 1 entries
+            std::vector<Run> runs;
+            
+            /**
+             * @brief Encodes the bitmap into runs
+             *
+             * @param width Bitmap width
+             * @param height Bitmap height
+             * @param alphaAt Callable (x, y) -> 4-bit alpha
+             */
+            template<typename AlphaAt>
+            void build(s32 width, s32 height, AlphaAt&& alphaAt) {
+                rowStart.clear();
+                runs.clear();
+                if (width <= 0 || height <= 0) return;
+                
+                rowStart.reserve(height + 1);
+                for (s32 y = 0; y < height; ++y) {
+                    rowStart.push_back(static_cast<u32>(runs.size()));
+                    
+                    s32 x = 0;
+                    while (x < width) {
+                        u8 alpha = alphaAt(x, y);
+                        if (!alpha) {
+                            ++x;
+                            continue;
+                        }
+                        
+                        const bool opaque = (alpha == 0xF);
+                        const s32 start = x;
+                        do {
+                            ++x;
+                        } while (x < width && (alpha = alphaAt(x, y)) != 0 && (alpha == 0xF) == opaque);
+                        
+                        runs.push_back({static_cast<u16>(start), static_cast<u16>(x - start), opaque});
+                    }
+                }
+                rowStart.push_back(static_cast<u32>(runs.size()));
+                
+                runs.shrink_to_fit();
+            }
+            
+            inline bool empty() const {
+                return runs.empty();
+            }
+            
+            inline size_t memoryUsage() const {
+                return rowStart.capacity() * sizeof(u32) + runs.capacity() * sizeof(Run);
+            }
+        };
+        
         #ifdef UI_OVERRIDE_PATH
         inline static std::shared_mutex s_translationCacheMutex;
         #endif
@@ -898,6 +1506,7 @@ namespace tsl {
                 int xAdvance;
                 u8 *glyphBmp;
                 int width, height;
+                AlphaRuns runs;  // Row runs over glyphBmp, used by the blitter
                 
                 // Add destructor to ensure cleanup
                 ~Glyph() {
@@ -915,7 +1524,7 @@ namespace tsl {
                 Glyph(Glyph&& other) noexcept 
                     : currFont(other.currFont), currFontSize(other.currFontSize)
                     , xAdvance(other.xAdvance), glyphBmp(other.glyphBmp)
-                    , width(other.width), height(other.height) {
+                    , width(other.width), height(other.height), runs(std::move(other.runs)) {
                     __builtin_memcpy(bounds, other.bounds, sizeof(bounds));
                     other.glyphBmp = nullptr; // Prevent double-free
                 }
@@ -931,6 +1540,7 @@ namespace tsl {
                         glyphBmp = other.glyphBmp;
                         width = other.width;
                         height = other.height;
+                        runs = std::move(other.runs);
                         __builtin_memcpy(bounds, other.bounds, sizeof(bounds));
                         other.glyphBmp = nullptr;
                     }
@@ -941,18 +1551,99 @@ namespace tsl {
                           glyphBmp(nullptr), width(0), height(0) {
                     std::memset(bounds, 0, sizeof(bounds));
                 }
+                
+                // Encodes glyphBmp into row runs (call once the bitmap is final)
+                void buildRuns() {
+                    if (!glyphBmp) return;
+                    runs.build(width, height, [this](s32 x, s32 y) -> u8 {
+                        return glyphBmp[y * width + x] >> 4;
+                    });
+                }
             };
             
         private:
+            /**
+             * @brief Cache slot for a rasterized glyph
+             * @note Lives inside an unordered_map node, so it is never moved and may hold an atomic.
+             *       The reference bit is set by readers under the shared lock and cleared by the CLOCK sweep.
+             *       Pinned entries (glyphs a recorded display list still has to draw) are never evicted.
+             */
+            struct CacheEntry {
+                std::unique_ptr<Glyph> glyph;
+                size_t bytes = 0;
+                mutable std::atomic<bool> referenced{true};
+                mutable std::atomic<u32> pins{0};
+            };
+            
             inline static std::shared_mutex s_cacheMutex;
             inline static std::mutex s_initMutex;
             
             // Use unique_ptr to ensure proper cleanup
-            inline static std::unordered_map<u64, std::unique_ptr<Glyph>> s_sharedGlyphCache;
+            inline static std::unordered_map<u64, CacheEntry> s_sharedGlyphCache;
             
-            // Add cache size limits
-            static constexpr size_t MAX_CACHE_SIZE = 10000;
-            static constexpr size_t CLEANUP_THRESHOLD = 8000;
+            // CLOCK ring of cached keys; the hand only advances under the exclusive lock
+            inline static std::vector<u64> s_clockRing;
+            inline static size_t s_clockHand = 0;
+            
+            // Memory budget (bitmap bytes plus per-entry bookkeeping)
+            static constexpr size_t DEFAULT_CACHE_MEMORY = 1024 * 1024;
+            inline static size_t s_memoryBudget = DEFAULT_CACHE_MEMORY;
+            inline static size_t s_cacheBytes = 0;
+            
+            // Bumped whenever glyph metrics may have changed, so dependent caches can invalidate themselves
+            inline static std::atomic<u32> s_generation{0};
+            
+            // Cache statistics
+            inline static std::atomic<u64> s_cacheHits{0};
+            inline static std::atomic<u64> s_cacheMisses{0};
+            inline static std::atomic<u64> s_cacheEvictions{0};
+            
+            /**
+             * @brief Direct-mapped glyph table for codepoints 0-255 at one font size
+             * @note Slots are claimed and filled under the exclusive lock, but read without any lock.
+             *       Glyphs published here are pinned: they are never evicted, only freed by clearCache/cleanup.
+             */
+            struct DirectGlyphTable {
+                std::atomic<u32> tag;  // DIRECT_TAG_VALID | mono bit | fontSize, 0 when unused (zero-initialized)
+                std::atomic<Glyph*> glyphs[256];
+            };
+            
+            static constexpr size_t MAX_DIRECT_TABLES = 16;
+            static constexpr u32 DIRECT_TAG_VALID = 1u << 31;
+            static constexpr u32 DIRECT_TAG_MONO  = 1u << 30;
+            inline static DirectGlyphTable s_directTables[MAX_DIRECT_TABLES];
+            inline static size_t s_directBytes = 0;
+            inline static size_t s_directCount = 0;
+            
+            // Background glyph pre-rasterization
+            inline static std::thread s_preloadThread;
+            inline static std::atomic<bool> s_preloadAbort{false};
+            inline static thread_local bool s_preloading = false; // Set while this thread runs preloadGlyphs
+            inline static std::mutex s_preloadMutex;
+            
+            /**
+             * @brief Codepoint to font map, 2 bits per codepoint (0 = unresolved, 1 = std, 2 = local, 3 = ext)
+             * @note Two levels: 1024-codepoint blocks allocated on first use. Entries are only ever OR-ed in
+             *       with the same deterministic value, so concurrent resolves under the shared lock are safe.
+             *       Blocks are freed only with s_cacheMutex held exclusively.
+             */
+            static constexpr u32 FONT_MAP_BLOCK_BITS = 10;
+            static constexpr u32 FONT_MAP_BLOCKS     = 0x110000 >> FONT_MAP_BLOCK_BITS;
+            static constexpr u32 FONT_MAP_WORDS      = (2u << FONT_MAP_BLOCK_BITS) / 64;
+            inline static std::atomic<std::atomic<u64>*> s_fontMap[FONT_MAP_BLOCKS];
+            
+            // Persistent on-disk glyph cache
+            static constexpr u32 PERSISTENT_CACHE_MAGIC   = 0x474C5354; // 'TSLG'
+            static constexpr u32 PERSISTENT_CACHE_VERSION = 1;
+            #ifdef APP_VERSION
+            static constexpr const char* PERSISTENT_CACHE_BUILD = APP_VERSION;
+            #else
+            static constexpr const char* PERSISTENT_CACHE_BUILD = __DATE__ " " __TIME__; // Unversioned builds never share a cache
+            #endif
+            inline static std::mutex s_persistentPathMutex;
+            inline static std::string s_persistentCachePath;
+            inline static bool s_persistentCachePathOverridden = false;
+            inline static bool s_persistentDirty = false;
             
             // font handles & state
             inline static stbtt_fontinfo* s_stdFont     = nullptr;
@@ -961,264 +1652,1991 @@ namespace tsl {
             inline static bool             s_hasLocalFont = false;
             inline static bool             s_initialized  = false;
             
-            // Fix cache key generation to prevent collisions
-            static u64 generateCacheKey(u32 character, bool monospace, u32 fontSize) {
-                // Use more bits for fontSize and separate monospace bit
-                u64 key = static_cast<u64>(character);
-                key = (key << 32) | static_cast<u64>(fontSize);
-                if (monospace) {
-                    key |= (1ULL << 63); // Use the highest bit for monospace
+            // Fix cache key generation to prevent collisions
+            static u64 generateCacheKey(u32 character, bool monospace, u32 fontSize) {
+                // Use more bits for fontSize and separate monospace bit
+                u64 key = static_cast<u64>(character);
+                key = (key << 32) | static_cast<u64>(fontSize);
+                if (monospace) {
+                    key |= (1ULL << 63); // Use the highest bit for monospace
+                }
+                return key;
+            }
+            
+            // Approximate heap footprint of one cached glyph
+            static size_t glyphFootprint(const Glyph& glyph) {
+                return sizeof(Glyph) + sizeof(CacheEntry) + sizeof(u64) * 2 +
+                       (glyph.glyphBmp ? static_cast<size_t>(glyph.width) * glyph.height : 0) +
+                       glyph.runs.memoryUsage();
+            }
+            
+            /**
+             * @brief Evicts glyphs with the CLOCK policy until the incoming glyph fits the budget
+             * @note Caller must hold s_cacheMutex exclusively.
+             *
+             * @param incomingBytes Footprint of the glyph about to be inserted
+             */
+            static void evictForSpace(size_t incomingBytes) {
+                // Two sweeps without an eviction mean everything left is pinned; go over budget until the pins drop
+                size_t sinceEviction = 0;
+                while (!s_clockRing.empty() && s_cacheBytes + incomingBytes > s_memoryBudget &&
+                       sinceEviction <= s_clockRing.size() * 2) {
+                    if (s_clockHand >= s_clockRing.size())
+                        s_clockHand = 0;
+                    
+                    auto it = s_sharedGlyphCache.find(s_clockRing[s_clockHand]);
+                    if (it != s_sharedGlyphCache.end() &&
+                        (it->second.pins.load(std::memory_order_relaxed) != 0 ||
+                         it->second.referenced.exchange(false, std::memory_order_relaxed))) {
+                        // Pinned or recently used, give it a second chance
+                        ++s_clockHand;
+                        ++sinceEviction;
+                        continue;
+                    }
+                    sinceEviction = 0;
+                    
+                    if (it != s_sharedGlyphCache.end()) {
+                        s_cacheBytes -= it->second.bytes;
+                        s_sharedGlyphCache.erase(it);
+                        s_cacheEvictions.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    
+                    // Swap-remove from the ring; the hand now points at the moved key
+                    s_clockRing[s_clockHand] = s_clockRing.back();
+                    s_clockRing.pop_back();
+                }
+            }
+            
+            static u32 directTag(bool monospace, u32 fontSize) {
+                return DIRECT_TAG_VALID | (monospace ? DIRECT_TAG_MONO : 0) | (fontSize & 0xFFFF);
+            }
+            
+            // Lock-free lookup of the direct table for a font size, nullptr if none was claimed yet
+            static DirectGlyphTable* findDirectTable(u32 tag) {
+                for (auto& table : s_directTables) {
+                    const u32 current = table.tag.load(std::memory_order_acquire);
+                    if (current == tag) return &table;
+                    if (current == 0) break; // Tables are claimed in order
+                }
+                return nullptr;
+            }
+            
+            // Finds or claims the direct table for a font size (exclusive lock held)
+            static DirectGlyphTable* claimDirectTableUnsafe(u32 tag) {
+                for (auto& table : s_directTables) {
+                    const u32 current = table.tag.load(std::memory_order_relaxed);
+                    if (current == tag) return &table;
+                    if (current == 0) {
+                        table.tag.store(tag, std::memory_order_release);
+                        return &table;
+                    }
+                }
+                return nullptr; // All tables in use, caller falls back to the hash map
+            }
+            
+            // Rasterizes a glyph (exclusive lock held)
+            static std::unique_ptr<Glyph> createGlyphUnsafe(u32 character, bool monospace, u32 fontSize) {
+                auto glyph = std::make_unique<Glyph>();
+                glyph->currFont = selectFontForCharacterUnsafe(character);
+                if (!glyph->currFont) {
+                    return nullptr;
+                }
+                
+                glyph->currFontSize = stbtt_ScaleForPixelHeight(glyph->currFont, fontSize);
+                
+                stbtt_GetCodepointBitmapBoxSubpixel(glyph->currFont, character, 
+                    glyph->currFontSize, glyph->currFontSize, 0, 0, 
+                    &glyph->bounds[0], &glyph->bounds[1], &glyph->bounds[2], &glyph->bounds[3]);
+                
+                s32 yAdvance = 0;
+                stbtt_GetCodepointHMetrics(glyph->currFont, monospace ? 'W' : character, 
+                                          &glyph->xAdvance, &yAdvance);
+                
+                glyph->glyphBmp = stbtt_GetCodepointBitmap(glyph->currFont, 
+                    glyph->currFontSize, glyph->currFontSize, character, 
+                    &glyph->width, &glyph->height, nullptr, nullptr);
+                glyph->buildRuns();
+                
+                if (isPersistentSize(fontSize))
+                    s_persistentDirty = true;
+                
+                return glyph;
+            }
+            
+            static void resetFontMapUnsafe() {
+                for (auto& block : s_fontMap) {
+                    delete[] block.exchange(nullptr, std::memory_order_relaxed);
+                }
+            }
+            
+            static void resetCacheUnsafe() {
+                s_sharedGlyphCache.clear(); // unique_ptr will handle cleanup
+                s_clockRing.clear();
+                s_clockHand = 0;
+                s_cacheBytes = 0;
+                
+                // Unpublish first so lock-free readers fall through to the locked path
+                for (auto& table : s_directTables) {
+                    table.tag.store(0, std::memory_order_release);
+                    for (auto& slot : table.glyphs) {
+                        delete slot.exchange(nullptr, std::memory_order_acq_rel);
+                    }
+                }
+                s_directBytes = 0;
+                s_directCount = 0;
+            }
+            
+        public:
+            static void initializeFonts(stbtt_fontinfo* stdFont, stbtt_fontinfo* localFont, 
+                                      stbtt_fontinfo* extFont, bool hasLocalFont) {
+                std::lock_guard<std::mutex> initLock(s_initMutex);
+                std::unique_lock<std::shared_mutex> cacheLock(s_cacheMutex);
+                
+                s_stdFont = stdFont;
+                s_localFont = localFont;
+                s_extFont = extFont;
+                s_hasLocalFont = hasLocalFont;
+                resetFontMapUnsafe();
+                s_generation.fetch_add(1, std::memory_order_release);
+                s_initialized = true;
+            }
+            
+            static stbtt_fontinfo* selectFontForCharacter(u32 character) {
+                std::shared_lock<std::shared_mutex> lock(s_cacheMutex);
+                return selectFontForCharacterUnsafe(character);
+            }
+            
+            /**
+             * @brief Gets a glyph, rasterizing it on a miss
+             * @note Glyphs from the evictable cache may be freed by the next insert on any thread. Pass pins to
+             *       keep them alive: the entry is pinned under the cache lock, its key appended, and it stays until
+             *       unpinGlyphs. Latin-1 glyphs in the direct tables live until clearCache and are not pinned.
+             *
+             * @param character Codepoint
+             * @param monospace Monospace metrics
+             * @param fontSize Font size
+             * @param pins Receives the keys of pinned glyphs, nullptr to not pin
+             * @return Glyph, nullptr if the fonts are not initialized or no font has the codepoint
+             */
+            static Glyph* getOrCreateGlyph(u32 character, bool monospace, u32 fontSize, std::vector<u64>* pins = nullptr) {
+                // Latin-1 fast path: direct index without any lock
+                if (character < 256) {
+                    if (DirectGlyphTable* table = findDirectTable(directTag(monospace, fontSize))) {
+                        if (Glyph* glyph = table->glyphs[character].load(std::memory_order_acquire)) {
+                            s_cacheHits.fetch_add(1, std::memory_order_relaxed);
+                            return glyph;
+                        }
+                    }
+                    return createDirectGlyph(character, monospace, fontSize, pins);
+                }
+                
+                const u64 key = generateCacheKey(character, monospace, fontSize);
+                
+                // First, try to find existing glyph with shared lock
+                {
+                    std::shared_lock<std::shared_mutex> readLock(s_cacheMutex);
+                    
+                    if (!s_initialized) return nullptr;
+                    
+                    auto it = s_sharedGlyphCache.find(key);
+                    if (it != s_sharedGlyphCache.end()) {
+                        it->second.referenced.store(true, std::memory_order_relaxed);
+                        s_cacheHits.fetch_add(1, std::memory_order_relaxed);
+                        pinEntryUnsafe(key, it->second, pins);
+                        return it->second.glyph.get();
+                    }
+                }
+                
+                // Glyph not found, need to create it with exclusive lock
+                std::unique_lock<std::shared_mutex> writeLock(s_cacheMutex);
+                
+                if (!s_initialized) return nullptr;
+                
+                return findOrInsertGlyphUnsafe(key, character, monospace, fontSize, pins);
+            }
+            
+            /**
+             * @brief Releases glyphs pinned through getOrCreateGlyph
+             * @note Evicts back down to the budget, which pinned glyphs may have pushed the cache over.
+             *
+             * @param keys Keys collected by getOrCreateGlyph, cleared on return
+             */
+            static void unpinGlyphs(std::vector<u64>& keys) {
+                if (keys.empty())
+                    return;
+                
+                {
+                    std::unique_lock<std::shared_mutex> lock(s_cacheMutex);
+                    for (const u64 key : keys) {
+                        auto it = s_sharedGlyphCache.find(key);
+                        if (it == s_sharedGlyphCache.end())
+                            continue;
+                        
+                        // A cleared cache may have handed the key to a new, unpinned entry
+                        const u32 count = it->second.pins.load(std::memory_order_relaxed);
+                        if (count != 0)
+                            it->second.pins.store(count - 1, std::memory_order_relaxed);
+                    }
+                    evictForSpace(0);
+                }
+                keys.clear();
+            }
+            
+            static void clearCache() {
+                // The preload worker holds direct-table glyph pointers between locks
+                stopPreload();
+                
+                std::unique_lock<std::shared_mutex> cacheLock(s_cacheMutex);
+                resetCacheUnsafe();
+                s_generation.fetch_add(1, std::memory_order_release);
+            }
+            
+            static void cleanup() {
+                stopPreload();
+                
+                std::lock_guard<std::mutex> initLock(s_initMutex);
+                std::unique_lock<std::shared_mutex> cacheLock(s_cacheMutex);
+                
+                resetCacheUnsafe();
+                resetFontMapUnsafe();
+                s_generation.fetch_add(1, std::memory_order_release);
+                s_initialized = false;
+                s_stdFont = nullptr;
+                s_localFont = nullptr;
+                s_extFont = nullptr;
+                s_hasLocalFont = false;
+            }
+            
+            static size_t getCacheSize() {
+                std::shared_lock<std::shared_mutex> lock(s_cacheMutex);
+                return s_sharedGlyphCache.size() + s_directCount;
+            }
+            
+            static bool isInitialized() {
+                std::shared_lock<std::shared_mutex> lock(s_cacheMutex);
+                return s_initialized;
+            }
+            
+            // Changes whenever fonts are (re)initialized or the glyph cache is cleared
+            static u32 getGeneration() {
+                return s_generation.load(std::memory_order_acquire);
+            }
+            
+            // Memory usage of the glyph cache in bytes (bitmaps plus bookkeeping, pinned Latin-1 glyphs included)
+            static size_t getMemoryUsage() {
+                std::shared_lock<std::shared_mutex> lock(s_cacheMutex);
+                return s_cacheBytes + s_directBytes;
+            }
+            
+            /**
+             * @brief Sets the glyph cache memory budget, evicting immediately if it shrinks
+             *
+             * @param bytes Budget in bytes
+             */
+            static void setMemoryBudget(size_t bytes) {
+                std::unique_lock<std::shared_mutex> lock(s_cacheMutex);
+                s_memoryBudget = bytes;
+                evictForSpace(0);
+            }
+            
+            static size_t getMemoryBudget() {
+                std::shared_lock<std::shared_mutex> lock(s_cacheMutex);
+                return s_memoryBudget;
+            }
+            
+            // Hits include lock-free direct-table reads
+            struct CacheStats {
+                size_t entries;
+                size_t directEntries;
+                size_t memoryUsage;
+                size_t memoryBudget;
+                u64 hits;
+                u64 misses;
+                u64 evictions;
+            };
+            
+            static CacheStats getCacheStats() {
+                std::shared_lock<std::shared_mutex> lock(s_cacheMutex);
+                return {
+                    s_sharedGlyphCache.size(),
+                    s_directCount,
+                    s_cacheBytes + s_directBytes,
+                    s_memoryBudget,
+                    s_cacheHits.load(std::memory_order_relaxed),
+                    s_cacheMisses.load(std::memory_order_relaxed),
+                    s_cacheEvictions.load(std::memory_order_relaxed)
+                };
+            }
+            
+            static void resetCacheStats() {
+                s_cacheHits.store(0, std::memory_order_relaxed);
+                s_cacheMisses.store(0, std::memory_order_relaxed);
+                s_cacheEvictions.store(0, std::memory_order_relaxed);
+            }
+            
+            /// Font sizes used by the standard UI elements, most common first
+            static constexpr u32 UI_FONT_SIZES[] = {23, 20, 15, 16, 32};
+            
+            /**
+             * @brief Rasterizes a set of glyphs ahead of time on the calling thread
+             * @note Preloading never evicts: other threads may be using any cached glyph. Codepoints that would
+             *       go to the evictable cache are skipped once it reaches 3/4 of its budget, checked under the
+             *       same lock that inserts them.
+             *
+             * @param codepoints Codepoints to rasterize
+             * @param fontSizes Font sizes to rasterize each codepoint at
+             * @param monospace Monospace glyph metrics
+             */
+            static void preloadGlyphs(const std::vector<u32>& codepoints, const std::vector<u32>& fontSizes, bool monospace = false) {
+                const bool preloading = s_preloading;
+                s_preloading = true;
+                
+                bool running = true;
+                for (auto size = fontSizes.begin(); running && size != fontSizes.end(); ++size) {
+                    for (auto character = codepoints.begin(); running && character != codepoints.end(); ++character) {
+                        running = !s_preloadAbort.load(std::memory_order_relaxed);
+                        
+                        // Misses are skipped codepoints unless the fonts are gone
+                        if (running && !getOrCreateGlyph(*character, monospace, *size))
+                            running = isInitialized();
+                    }
+                }
+                
+                s_preloading = preloading;
+            }
+            
+            /**
+             * @brief Collects the glyphs the UI is about to show and rasterizes them on a background thread
+             * @note ASCII is warmed at every standard UI size first, then all codepoints of the active
+             *       translation table. Call after startup and after language or theme changes.
+             *       Any preload still in flight is cancelled first.
+             *
+             * @param extraStrings Additional strings to warm (e.g. localized labels not in the translation table)
+             */
+            static void preloadStandardGlyphsAsync(const std::vector<std::string>& extraStrings = {}) {
+                stopPreload();
+                
+                if (!isInitialized())
+                    return;
+                
+                // Gather on the caller's thread so the translation table is never touched concurrently
+                std::vector<u32> asciiCodepoints;
+                asciiCodepoints.reserve(95);
+                for (u32 c = 0x20; c < 0x7F; ++c)
+                    asciiCodepoints.push_back(c);
+                
+                std::vector<u32> localizedCodepoints;
+                {
+                    std::unordered_set<u32> seen;
+                    auto collect = [&](const std::string& str) {
+                        const u8* it = reinterpret_cast<const u8*>(str.c_str());
+                        u32 character;
+                        while (*it) {
+                            const ssize_t width = decode_utf8(&character, it);
+                            if (width <= 0) break;
+                            it += width;
+                            if (character >= 0x7F && seen.insert(character).second)
+                                localizedCodepoints.push_back(character);
+                        }
+                    };
+                    
+                    {
+                        #ifdef UI_OVERRIDE_PATH
+                        std::shared_lock<std::shared_mutex> readLock(s_translationCacheMutex);
+                        #endif
+                        for (const auto& entry : ult::translationCache)
+                            collect(entry.second);
+                    }
+                    collect(ult::OK);
+                    collect(ult::BACK);
+                    for (const auto& str : extraStrings)
+                        collect(str);
+                }
+                
+                const std::vector<u32> fontSizes(std::begin(UI_FONT_SIZES), std::end(UI_FONT_SIZES));
+                
+                std::lock_guard<std::mutex> lock(s_preloadMutex);
+                s_preloadAbort.store(false, std::memory_order_relaxed);
+                s_preloadThread = std::thread([asciiCodepoints = std::move(asciiCodepoints),
+                                               localizedCodepoints = std::move(localizedCodepoints), fontSizes]() {
+                    preloadGlyphs(asciiCodepoints, fontSizes);
+                    preloadGlyphs(localizedCodepoints, fontSizes);
+                });
+            }
+            
+            /**
+             * @brief Cancels and joins a background preload, if one is running
+             */
+            static void stopPreload() {
+                std::lock_guard<std::mutex> lock(s_preloadMutex);
+                if (s_preloadThread.joinable()) {
+                    s_preloadAbort.store(true, std::memory_order_relaxed);
+                    s_preloadThread.join();
+                }
+            }
+            
+            /**
+             * @brief Overrides where the persistent glyph cache is stored
+             *
+             * @param path Cache file path, empty to disable the persistent cache
+             */
+            static void setPersistentCachePath(const std::string& path) {
+                std::lock_guard<std::mutex> lock(s_persistentPathMutex);
+                s_persistentCachePath = path;
+                s_persistentCachePathOverridden = true;
+            }
+            
+            /**
+             * @brief Loads glyphs rasterized by a previous run with a single file read
+             * @note The file is ignored unless it was written for the same fonts, UI sizes, build version
+             *       (APP_VERSION) and format version.
+             *       Bitmaps are stored with 4-bit coverage, which is all the renderer uses.
+             *
+             * @return Number of glyphs loaded
+             */
+            static size_t loadPersistentCache() {
+                const std::string path = persistentCachePath();
+                if (path.empty())
+                    return 0;
+                
+                FILE* file = fopen(path.c_str(), "rb");
+                if (!file)
+                    return 0;
+                
+                fseek(file, 0, SEEK_END);
+                const long fileSize = ftell(file);
+                fseek(file, 0, SEEK_SET);
+                
+                std::vector<u8> buffer(fileSize > 0 ? static_cast<size_t>(fileSize) : 0);
+                const bool readOk = !buffer.empty() && fread(buffer.data(), 1, buffer.size(), file) == buffer.size();
+                fclose(file);
+                if (!readOk)
+                    return 0;
+                
+                const u8* cursor = buffer.data();
+                const u8* const end = cursor + buffer.size();
+                auto read = [&cursor, end](void* out, size_t size) {
+                    if (static_cast<size_t>(end - cursor) < size) return false;
+                    std::memcpy(out, cursor, size);
+                    cursor += size;
+                    return true;
+                };
+                
+                std::unique_lock<std::shared_mutex> writeLock(s_cacheMutex);
+                if (!s_initialized)
+                    return 0;
+                
+                u32 magic = 0, glyphCount = 0;
+                u64 cacheKey = 0;
+                if (!read(&magic, sizeof(magic)) || magic != PERSISTENT_CACHE_MAGIC ||
+                    !read(&cacheKey, sizeof(cacheKey)) || cacheKey != persistentCacheKeyUnsafe() ||
+                    !read(&glyphCount, sizeof(glyphCount)))
+                    return 0;
+                
+                stbtt_fontinfo* const fonts[3] = { s_stdFont, s_localFont, s_extFont };
+                size_t loaded = 0;
+                
+                for (u32 i = 0; i < glyphCount; ++i) {
+                    u32 character, sizeTag;
+                    u8 fontIndex;
+                    u16 width, height;
+                    auto glyph = std::make_unique<Glyph>();
+                    
+                    if (!read(&character, sizeof(character)) || !read(&sizeTag, sizeof(sizeTag)) ||
+                        !read(&fontIndex, sizeof(fontIndex)) || !read(&glyph->currFontSize, sizeof(glyph->currFontSize)) ||
+                        !read(glyph->bounds, sizeof(glyph->bounds)) || !read(&glyph->xAdvance, sizeof(glyph->xAdvance)) ||
+                        !read(&width, sizeof(width)) || !read(&height, sizeof(height)) || fontIndex > 2)
+                        break;
+                    
+                    const size_t pixels = static_cast<size_t>(width) * height;
+                    const size_t packedSize = (pixels + 1) / 2;
+                    if (static_cast<size_t>(end - cursor) < packedSize)
+                        break;
+                    
+                    glyph->currFont = fonts[fontIndex];
+                    glyph->width = width;
+                    glyph->height = height;
+                    
+                    if (pixels) {
+                        // Freed by stbtt_FreeBitmap, which releases with free()
+                        glyph->glyphBmp = static_cast<u8*>(malloc(pixels));
+                        if (!glyph->glyphBmp)
+                            break;
+                        for (size_t p = 0; p < pixels; ++p) {
+                            const u8 nibble = (p & 1) ? (cursor[p >> 1] & 0x0F) : (cursor[p >> 1] >> 4);
+                            glyph->glyphBmp[p] = (nibble << 4) | nibble;
+                        }
+                        glyph->buildRuns();
+                    }
+                    cursor += packedSize;
+                    
+                    const bool monospace = sizeTag & DIRECT_TAG_MONO;
+                    const u32 fontSize = sizeTag & 0xFFFF;
+                    
+                    if (character < 256) {
+                        DirectGlyphTable* table = claimDirectTableUnsafe(directTag(monospace, fontSize));
+                        if (table && !table->glyphs[character].load(std::memory_order_relaxed)) {
+                            publishDirectGlyphUnsafe(table, character, std::move(glyph));
+                            ++loaded;
+                            continue;
+                        }
+                    }
+                    
+                    // Leave headroom in the evictable cache for glyphs this session actually needs
+                    const u64 key = generateCacheKey(character, monospace, fontSize);
+                    if (s_cacheBytes < s_memoryBudget / 4 * 3 && s_sharedGlyphCache.find(key) == s_sharedGlyphCache.end()) {
+                        insertCachedGlyphUnsafe(key, std::move(glyph));
+                        ++loaded;
+                    }
+                }
+                
+                s_persistentDirty = false;
+                return loaded;
+            }
+            
+            /**
+             * @brief Writes all cached glyphs at the standard UI sizes to the persistent cache file
+             * @note Does nothing if no such glyph was rasterized since the cache was last loaded or saved.
+             *
+             * @return true if the file was written
+             */
+            static bool savePersistentCache() {
+                const std::string path = persistentCachePath();
+                if (path.empty())
+                    return false;
+                
+                std::vector<u8> buffer;
+                auto write = [&buffer](const void* data, size_t size) {
+                    const u8* bytes = static_cast<const u8*>(data);
+                    buffer.insert(buffer.end(), bytes, bytes + size);
+                };
+                
+                {
+                    std::unique_lock<std::shared_mutex> writeLock(s_cacheMutex);
+                    if (!s_initialized || !s_persistentDirty)
+                        return false;
+                    
+                    u32 glyphCount = 0;
+                    write(&PERSISTENT_CACHE_MAGIC, sizeof(PERSISTENT_CACHE_MAGIC));
+                    const u64 cacheKey = persistentCacheKeyUnsafe();
+                    write(&cacheKey, sizeof(cacheKey));
+                    const size_t countOffset = buffer.size();
+                    write(&glyphCount, sizeof(glyphCount));
+                    
+                    auto serialize = [&](u32 character, u32 sizeTag, const Glyph* glyph) {
+                        if (!glyph || !isPersistentSize(sizeTag & 0xFFFF))
+                            return;
+                        
+                        const u8 fontIndex = glyph->currFont == s_extFont ? 2 : (glyph->currFont == s_localFont ? 1 : 0);
+                        const u16 width = glyph->glyphBmp ? static_cast<u16>(glyph->width) : 0;
+                        const u16 height = glyph->glyphBmp ? static_cast<u16>(glyph->height) : 0;
+                        
+                        write(&character, sizeof(character));
+                        write(&sizeTag, sizeof(sizeTag));
+                        write(&fontIndex, sizeof(fontIndex));
+                        write(&glyph->currFontSize, sizeof(glyph->currFontSize));
+                        write(glyph->bounds, sizeof(glyph->bounds));
+                        write(&glyph->xAdvance, sizeof(glyph->xAdvance));
+                        write(&width, sizeof(width));
+                        write(&height, sizeof(height));
+                        
+                        // Pack coverage to 4 bits, two pixels per byte
+                        const size_t pixels = static_cast<size_t>(width) * height;
+                        const size_t packedOffset = buffer.size();
+                        buffer.resize(packedOffset + (pixels + 1) / 2, 0);
+                        for (size_t p = 0; p < pixels; ++p) {
+                            const u8 nibble = glyph->glyphBmp[p] >> 4;
+                            buffer[packedOffset + (p >> 1)] |= (p & 1) ? nibble : (nibble << 4);
+                        }
+                        ++glyphCount;
+                    };
+                    
+                    for (const auto& table : s_directTables) {
+                        const u32 tag = table.tag.load(std::memory_order_relaxed);
+                        if (tag == 0) break;
+                        for (u32 character = 0; character < 256; ++character)
+                            serialize(character, tag & ~DIRECT_TAG_VALID, table.glyphs[character].load(std::memory_order_relaxed));
+                    }
+                    
+                    for (const auto& [key, entry] : s_sharedGlyphCache) {
+                        const u32 sizeTag = static_cast<u32>(key & 0xFFFFFFFF) | ((key >> 63) ? DIRECT_TAG_MONO : 0);
+                        serialize(static_cast<u32>((key >> 32) & 0x7FFFFFFF), sizeTag, entry.glyph.get());
+                    }
+                    
+                    std::memcpy(buffer.data() + countOffset, &glyphCount, sizeof(glyphCount));
+                    s_persistentDirty = false;
+                }
+                
+                // Write to a temporary file first so an interrupted save never leaves a torn cache behind
+                const std::string tempPath = path + ".tmp";
+                FILE* file = fopen(tempPath.c_str(), "wb");
+                if (!file)
+                    return false;
+                const bool writeOk = fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size();
+                fclose(file);
+                
+                if (!writeOk) {
+                    std::remove(tempPath.c_str());
+                    return false;
+                }
+                std::remove(path.c_str());
+                return std::rename(tempPath.c_str(), path.c_str()) == 0;
+            }
+            
+        private:
+            // Inserts a rasterized glyph into the evictable cache (exclusive lock held)
+            static Glyph* insertCachedGlyphUnsafe(u64 key, std::unique_ptr<Glyph> glyph) {
+                // Make room under the memory budget before inserting (preloading only fills free space)
+                const size_t bytes = glyphFootprint(*glyph);
+                if (!s_preloading)
+                    evictForSpace(bytes);
+                
+                Glyph* glyphPtr = glyph.get();
+                CacheEntry& entry = s_sharedGlyphCache[key];
+                entry.glyph = std::move(glyph);
+                entry.bytes = bytes;
+                s_clockRing.push_back(key);
+                s_cacheBytes += bytes;
+                
+                return glyphPtr;
+            }
+            
+            // Publishes a rasterized glyph into a direct table (exclusive lock held)
+            static Glyph* publishDirectGlyphUnsafe(DirectGlyphTable* table, u32 character, std::unique_ptr<Glyph> glyph) {
+                s_directBytes += glyphFootprint(*glyph) - sizeof(CacheEntry) - sizeof(u64) * 2;
+                ++s_directCount;
+                
+                Glyph* glyphPtr = glyph.release();
+                table->glyphs[character].store(glyphPtr, std::memory_order_release);
+                return glyphPtr;
+            }
+            
+            // Pins an evictable entry for the caller (shared or exclusive lock held)
+            static void pinEntryUnsafe(u64 key, const CacheEntry& entry, std::vector<u64>* pins) {
+                if (!pins) return;
+                entry.pins.fetch_add(1, std::memory_order_relaxed);
+                pins->push_back(key);
+            }
+            
+            // Hash map lookup/insert for the evictable cache (exclusive lock held)
+            static Glyph* findOrInsertGlyphUnsafe(u64 key, u32 character, bool monospace, u32 fontSize, std::vector<u64>* pins = nullptr) {
+                // Double-check pattern
+                auto it = s_sharedGlyphCache.find(key);
+                if (it != s_sharedGlyphCache.end()) {
+                    it->second.referenced.store(true, std::memory_order_relaxed);
+                    s_cacheHits.fetch_add(1, std::memory_order_relaxed);
+                    pinEntryUnsafe(key, it->second, pins);
+                    return it->second.glyph.get();
+                }
+                
+                s_cacheMisses.fetch_add(1, std::memory_order_relaxed);
+                
+                if (s_preloading && s_cacheBytes >= s_memoryBudget / 4 * 3)
+                    return nullptr;
+                
+                auto glyph = createGlyphUnsafe(character, monospace, fontSize);
+                if (!glyph) return nullptr;
+                
+                Glyph* glyphPtr = insertCachedGlyphUnsafe(key, std::move(glyph));
+                if (pins)
+                    pinEntryUnsafe(key, s_sharedGlyphCache.find(key)->second, pins);
+                return glyphPtr;
+            }
+            
+            // Slow path of the Latin-1 fast path: rasterize and publish into the direct table
+            static Glyph* createDirectGlyph(u32 character, bool monospace, u32 fontSize, std::vector<u64>* pins = nullptr) {
+                std::unique_lock<std::shared_mutex> writeLock(s_cacheMutex);
+                
+                if (!s_initialized) return nullptr;
+                
+                const u32 tag = directTag(monospace, fontSize);
+                DirectGlyphTable* table = claimDirectTableUnsafe(tag);
+                if (!table) {
+                    // Out of direct tables, use the evictable cache instead
+                    return findOrInsertGlyphUnsafe(generateCacheKey(character, monospace, fontSize), character, monospace, fontSize, pins);
+                }
+                
+                if (Glyph* existing = table->glyphs[character].load(std::memory_order_relaxed)) {
+                    s_cacheHits.fetch_add(1, std::memory_order_relaxed);
+                    return existing;
+                }
+                
+                s_cacheMisses.fetch_add(1, std::memory_order_relaxed);
+                
+                auto glyph = createGlyphUnsafe(character, monospace, fontSize);
+                if (!glyph) return nullptr;
+                
+                return publishDirectGlyphUnsafe(table, character, std::move(glyph));
+            }
+            
+            static bool isPersistentSize(u32 fontSize) {
+                for (const u32 size : UI_FONT_SIZES)
+                    if (size == fontSize) return true;
+                return false;
+            }
+            
+            // FNV-1a over a font's glyph count and 'head' table (checksum, creation and modification dates)
+            static u64 fontIdentity(const stbtt_fontinfo* font, u64 hash) {
+                auto mix = [&hash](const void* data, size_t size) {
+                    const u8* bytes = static_cast<const u8*>(data);
+                    for (size_t i = 0; i < size; ++i) {
+                        hash ^= bytes[i];
+                        hash *= 0x100000001B3ULL;
+                    }
+                };
+                
+                if (!font || !font->data) {
+                    mix("none", 4);
+                    return hash;
+                }
+                
+                mix(&font->numGlyphs, sizeof(font->numGlyphs));
+                if (font->head)
+                    mix(font->data + font->head, 54); // Size of the TrueType 'head' table
+                return hash;
+            }
+            
+            // Identity of the current font set, configured sizes, library build and file format (lock held)
+            static u64 persistentCacheKeyUnsafe() {
+                u64 hash = 0xCBF29CE484222325ULL;
+                hash = fontIdentity(s_stdFont, hash);
+                hash = fontIdentity(s_hasLocalFont ? s_localFont : nullptr, hash);
+                hash = fontIdentity(s_extFont, hash);
+                for (const u32 size : UI_FONT_SIZES) {
+                    hash ^= size;
+                    hash *= 0x100000001B3ULL;
+                }
+                // Rasterization can change between releases without the file format changing
+                for (const char* c = PERSISTENT_CACHE_BUILD; *c; ++c) {
+                    hash ^= static_cast<u8>(*c);
+                    hash *= 0x100000001B3ULL;
+                }
+                hash ^= PERSISTENT_CACHE_VERSION;
+                hash *= 0x100000001B3ULL;
+                return hash;
+            }
+            
+            static std::string persistentCachePath() {
+                std::lock_guard<std::mutex> lock(s_persistentPathMutex);
+                return s_persistentCachePathOverridden ? s_persistentCachePath : ult::SETTINGS_PATH + "glyph_cache.bin";
+            }
+            
+            // Resolves the font for a codepoint through the font map (s_cacheMutex held, shared or exclusive)
+            static stbtt_fontinfo* selectFontForCharacterUnsafe(u32 character) {
+                if (!s_initialized) return nullptr;
+                
+                if (character >= 0x110000)
+                    return findFontForCharacterUnsafe(character);
+                
+                auto& blockSlot = s_fontMap[character >> FONT_MAP_BLOCK_BITS];
+                std::atomic<u64>* block = blockSlot.load(std::memory_order_acquire);
+                if (!block) {
+                    std::atomic<u64>* fresh = new std::atomic<u64>[FONT_MAP_WORDS]();
+                    if (blockSlot.compare_exchange_strong(block, fresh, std::memory_order_acq_rel)) {
+                        block = fresh;
+                    } else {
+                        delete[] fresh; // Another reader won, block now holds its allocation
+                    }
+                }
+                
+                const u32 index = character & ((1u << FONT_MAP_BLOCK_BITS) - 1);
+                std::atomic<u64>& word = block[index >> 5];
+                const u32 shift = (index & 31) * 2;
+                
+                switch ((word.load(std::memory_order_relaxed) >> shift) & 0x3) {
+                    case 1: return s_stdFont;
+                    case 2: return s_localFont;
+                    case 3: return s_extFont;
+                    default: break;
+                }
+                
+                stbtt_fontinfo* font = findFontForCharacterUnsafe(character);
+                const u64 fontIndex = font == s_extFont ? 3 : (font == s_localFont ? 2 : 1);
+                word.fetch_or(fontIndex << shift, std::memory_order_relaxed);
+                return font;
+            }
+            
+            // Font fallback through the TrueType cmap tables
+            static stbtt_fontinfo* findFontForCharacterUnsafe(u32 character) {
+                if (stbtt_FindGlyphIndex(s_extFont, character)) {
+                    return s_extFont;
+                } else if (s_hasLocalFont && stbtt_FindGlyphIndex(s_localFont, character) != 0) {
+                    return s_localFont;
+                }
+                return s_stdFont;
+            }
+        };
+        
+        // Static member definitions
+       //std::shared_mutex FontManager::s_cacheMutex;
+       //std::mutex FontManager::s_initMutex;
+       //std::unordered_map<u64, FontManager::CacheEntry> FontManager::s_sharedGlyphCache;
+       //stbtt_fontinfo* FontManager::s_stdFont = nullptr;
+       //stbtt_fontinfo* FontManager::s_localFont = nullptr;
+       //stbtt_fontinfo* FontManager::s_extFont = nullptr;
+       //bool FontManager::s_hasLocalFont = false;
+       //bool FontManager::s_initialized = false;
+        
+        // Thread-safe translation cache access
+        static std::string getTranslatedText(const std::string& originalString) {
+            #ifdef UI_OVERRIDE_PATH
+            std::shared_lock<std::shared_mutex> readLock(s_translationCacheMutex);
+            auto translatedIt = ult::translationCache.find(originalString);
+            if (translatedIt != ult::translationCache.end()) {
+                return translatedIt->second;
+            }
+            
+            // Need to upgrade to write lock
+            readLock.unlock();
+            std::unique_lock<std::shared_mutex> writeLock(s_translationCacheMutex);
+            
+            // Double-check pattern
+            translatedIt = ult::translationCache.find(originalString);
+            if (translatedIt != ult::translationCache.end()) {
+                return translatedIt->second;
+            }
+            ult::translationCache[originalString] = originalString;
+            #endif
+            return originalString;
+        }
+        
+        /**
+         * @brief Byte-bounded LRU cache of immutable values keyed by (translated text, font size, monospace)
+         * @note Every entry is dropped once the FontManager generation changes (font init, clearCache).
+         *       Values are handed out as shared_ptr, so evicting an entry never frees one a caller still uses.
+         */
+        template<typename Value>
+        class TextCache {
+        public:
+            explicit TextCache(size_t memoryBudget) : m_memoryBudget(memoryBudget) {}
+            
+            /**
+             * @brief Gets the value of a string, building it on a miss
+             *
+             * @param text Translated text
+             * @param fontSize Font size
+             * @param monospace Monospace metrics
+             * @param build Builds the value outside the lock, called as build(text, fontSize, monospace)
+             * @param footprint Bytes a built value occupies, called as footprint(value)
+             * @return Shared value (never null)
+             */
+            template<typename Build, typename Footprint>
+            std::shared_ptr<const Value> get(const std::string& text, u32 fontSize, bool monospace, Build&& build, Footprint&& footprint) {
+                Key key{text, fontSize, monospace};
+                
+                {
+                    std::lock_guard<std::mutex> lock(this->m_mutex);
+                    this->validateUnsafe();
+                    
+                    auto it = this->m_entries.find(key);
+                    if (it != this->m_entries.end()) {
+                        this->m_lru.splice(this->m_lru.begin(), this->m_lru, it->second.lruIt);
+                        return it->second.value;
+                    }
+                }
+                
+                // Build outside the lock; getOrCreateGlyph has its own synchronization
+                const u32 generation = FontManager::getGeneration();
+                std::shared_ptr<const Value> value = build(text, fontSize, monospace);
+                
+                std::lock_guard<std::mutex> lock(this->m_mutex);
+                this->validateUnsafe();
+                if (generation != this->m_generation)
+                    return value; // Fonts changed while building, don't cache stale results
+                
+                auto it = this->m_entries.find(key);
+                if (it != this->m_entries.end())
+                    return it->second.value;
+                
+                const size_t bytes = sizeof(Entry) + text.size() * 2 + footprint(*value);
+                while (!this->m_lru.empty() && this->m_bytes + bytes > this->m_memoryBudget) {
+                    auto victim = this->m_entries.find(this->m_lru.back());
+                    this->m_bytes -= victim->second.bytes;
+                    this->m_entries.erase(victim);
+                    this->m_lru.pop_back();
+                }
+                
+                if (bytes <= this->m_memoryBudget) {
+                    this->m_lru.push_front(key);
+                    this->m_entries.emplace(std::move(key), Entry{value, this->m_lru.begin(), bytes});
+                    this->m_bytes += bytes;
+                }
+                return value;
+            }
+            
+            void clear() {
+                std::lock_guard<std::mutex> lock(this->m_mutex);
+                this->clearUnsafe();
+            }
+            
+            void setMemoryBudget(size_t bytes) {
+                std::lock_guard<std::mutex> lock(this->m_mutex);
+                this->m_memoryBudget = bytes;
+                this->clearUnsafe();
+            }
+            
+            size_t getMemoryUsage() {
+                std::lock_guard<std::mutex> lock(this->m_mutex);
+                return this->m_bytes;
+            }
+            
+        private:
+            struct Key {
+                std::string text;
+                u32 fontSize;
+                bool monospace;
+                
+                bool operator==(const Key& other) const {
+                    return fontSize == other.fontSize && monospace == other.monospace && text == other.text;
+                }
+            };
+            
+            struct KeyHash {
+                size_t operator()(const Key& key) const {
+                    u64 hash = std::hash<std::string>{}(key.text);
+                    hash ^= key.fontSize + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+                    hash ^= static_cast<u64>(key.monospace) + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+                    return static_cast<size_t>(hash);
+                }
+            };
+            
+            struct Entry {
+                std::shared_ptr<const Value> value;
+                typename std::list<Key>::iterator lruIt;
+                size_t bytes;
+            };
+            
+            std::mutex m_mutex;
+            std::unordered_map<Key, Entry, KeyHash> m_entries;
+            std::list<Key> m_lru;
+            size_t m_bytes = 0;
+            size_t m_memoryBudget;
+            u32 m_generation = 0;
+            
+            void clearUnsafe() {
+                this->m_entries.clear();
+                this->m_lru.clear();
+                this->m_bytes = 0;
+            }
+            
+            // Drops every entry once fonts were reinitialized or the glyph cache was cleared
+            void validateUnsafe() {
+                const u32 generation = FontManager::getGeneration();
+                if (generation != this->m_generation) {
+                    this->clearUnsafe();
+                    this->m_generation = generation;
+                }
+            }
+        };
+        
+        /**
+         * @brief Caches the measured layout of strings, keyed by (text, font size, monospace)
+         * @note Stores the same width/height drawString reports plus per-codepoint advance prefix sums,
+         *       so widths and truncation points no longer require re-decoding and re-walking glyphs.
+         *       Bounded by an LRU byte budget and invalidated whenever the FontManager generation changes.
+         */
+        class TextLayoutCache {
+        public:
+            struct Layout {
+                s32 width = 0;                   ///< Widest line, as returned by drawString
+                s32 height = 0;                  ///< Tallest extent below the origin, as returned by drawString
+                std::vector<s32> advancePrefix;  ///< advancePrefix[i] = summed advance of the first i codepoints
+                std::vector<u32> byteOffsets;    ///< byteOffsets[i] = byte offset after the first i codepoints
+            };
+            
+            /**
+             * @brief Gets the layout of an already translated string, measuring it on a miss
+             *
+             * @param text Translated text
+             * @param fontSize Font size
+             * @param monospace Monospace metrics
+             * @return Shared layout (never null)
+             */
+            static std::shared_ptr<const Layout> get(const std::string& text, u32 fontSize, bool monospace) {
+                return s_cache.get(text, fontSize, monospace, measure, [](const Layout& layout) {
+                    return sizeof(Layout) + layout.advancePrefix.size() * (sizeof(s32) + sizeof(u32));
+                });
+            }
+            
+            static void clear() {
+                s_cache.clear();
+            }
+            
+            static size_t getMemoryUsage() {
+                return s_cache.getMemoryUsage();
+            }
+            
+        private:
+            inline static TextCache<Layout> s_cache{256 * 1024};
+            
+            // Mirrors the measuring done by drawString (without special symbols)
+            static std::shared_ptr<Layout> measure(const std::string& text, u32 fontSize, bool monospace) {
+                auto layout = std::make_shared<Layout>();
+                layout->advancePrefix.reserve(text.size() + 1);
+                layout->byteOffsets.reserve(text.size() + 1);
+                layout->advancePrefix.push_back(0);
+                layout->byteOffsets.push_back(0);
+                
+                if (fontSize == 0)
+                    return layout;
+                
+                s32 maxX = 0, currX = 0, currY = 0, maxY = 0, totalAdvance = 0;
+                const u8* const begin = reinterpret_cast<const u8*>(text.data());
+                const u8* const end = begin + text.size();
+                const u8* it = begin;
+                u32 currCharacter;
+                ssize_t codepointWidth;
+                
+                while (it < end) {
+                    if (*it < 0x80) {
+                        currCharacter = *it;
+                        codepointWidth = 1;
+                    } else {
+                        codepointWidth = decode_utf8(&currCharacter, it);
+                        if (codepointWidth <= 0) break;
+                    }
+                    it += codepointWidth;
+                    
+                    FontManager::Glyph* glyph = FontManager::getOrCreateGlyph(currCharacter, monospace, fontSize);
+                    const s32 advance = glyph ? static_cast<s32>(glyph->xAdvance * glyph->currFontSize) : 0;
+                    totalAdvance += advance;
+                    layout->advancePrefix.push_back(totalAdvance);
+                    layout->byteOffsets.push_back(static_cast<u32>(it - begin));
+                    
+                    if (currCharacter == '\n') {
+                        maxX = std::max(currX, maxX);
+                        currX = 0;
+                        currY += static_cast<s32>(fontSize);
+                        continue;
+                    }
+                    
+                    if (!glyph) continue;
+                    
+                    maxY = std::max(maxY, currY + static_cast<s32>(glyph->height));
+                    currX += advance;
+                }
+                
+                layout->width = std::max(currX, maxX);
+                layout->height = maxY;
+                return layout;
+            }
+        };
+        
+        /**
+         * @brief Opt-in cache of prerendered text runs
+         * @note A run of text is rasterized once into a 4-bit coverage sprite (two pixels per byte) and later
+         *       frames blit it with span-level blending instead of compositing glyph by glyph. Sprites hold
+         *       coverage only, so one sprite serves every color and theme. They are keyed by (translated text,
+         *       font size, monospace), bounded by an LRU byte budget and dropped on FontManager generation
+         *       changes (font init, language/theme switches through clearCache).
+         */
+        class TextSpriteCache {
+        public:
+            struct Sprite {
+                s32 offsetX = 0, offsetY = 0;  ///< Top-left of the coverage box relative to the drawString origin
+                s32 width = 0, height = 0;     ///< Size of the coverage box
+                s32 layoutWidth = 0;           ///< Dimensions drawString reports for this text
+                s32 layoutHeight = 0;
+                std::vector<u8> coverage;      ///< 4-bit coverage, row-major, two pixels per byte (high nibble first)
+                AlphaRuns runs;                ///< Row runs over coverage
+                
+                inline u8 alphaAt(s32 x, s32 y) const {
+                    const size_t index = static_cast<size_t>(y) * width + x;
+                    return (index & 1) ? (coverage[index >> 1] & 0x0F) : (coverage[index >> 1] >> 4);
+                }
+            };
+            
+            static void setEnabled(bool enabled) {
+                s_enabled.store(enabled, std::memory_order_relaxed);
+                if (!enabled)
+                    clear();
+            }
+            
+            static bool isEnabled() {
+                return s_enabled.load(std::memory_order_relaxed);
+            }
+            
+            /**
+             * @brief Gets the sprite for an already translated string, rasterizing it on a miss
+             *
+             * @param text Translated text
+             * @param fontSize Font size
+             * @param monospace Monospace metrics
+             * @return Shared sprite (never null)
+             */
+            static std::shared_ptr<const Sprite> get(const std::string& text, u32 fontSize, bool monospace) {
+                return s_cache.get(text, fontSize, monospace, rasterize, [](const Sprite& sprite) {
+                    return sizeof(Sprite) + sprite.coverage.size() + sprite.runs.memoryUsage();
+                });
+            }
+            
+            static void clear() {
+                s_cache.clear();
+            }
+            
+            static void setMemoryBudget(size_t bytes) {
+                s_cache.setMemoryBudget(bytes);
+            }
+            
+            static size_t getMemoryUsage() {
+                return s_cache.getMemoryUsage();
+            }
+            
+        private:
+            inline static std::atomic<bool> s_enabled{false};
+            inline static TextCache<Sprite> s_cache{256 * 1024};
+            
+            // Walks the text exactly like drawString and calls visit(glyph, penX, penY) for every drawn glyph
+            template<typename Visitor>
+            static void walkGlyphs(const std::string& text, u32 fontSize, bool monospace, Visitor&& visit) {
+                const u8* it = reinterpret_cast<const u8*>(text.data());
+                const u8* const end = it + text.size();
+                s32 currX = 0, currY = 0;
+                u32 currCharacter;
+                ssize_t codepointWidth;
+                
+                while (it < end) {
+                    if (*it < 0x80) {
+                        currCharacter = *it;
+                        codepointWidth = 1;
+                    } else {
+                        codepointWidth = decode_utf8(&currCharacter, it);
+                        if (codepointWidth <= 0) break;
+                    }
+                    it += codepointWidth;
+                    
+                    if (currCharacter == '\n') {
+                        currX = 0;
+                        currY += static_cast<s32>(fontSize);
+                        continue;
+                    }
+                    
+                    FontManager::Glyph* glyph = FontManager::getOrCreateGlyph(currCharacter, monospace, fontSize);
+                    if (!glyph) continue;
+                    
+                    if (glyph->glyphBmp && currCharacter > 32)
+                        visit(glyph, currX, currY);
+                    
+                    currX += static_cast<s32>(glyph->xAdvance * glyph->currFontSize);
+                }
+            }
+            
+            static std::shared_ptr<Sprite> rasterize(const std::string& text, u32 fontSize, bool monospace) {
+                auto sprite = std::make_shared<Sprite>();
+                
+                const auto layout = TextLayoutCache::get(text, fontSize, monospace);
+                sprite->layoutWidth = layout->width;
+                sprite->layoutHeight = layout->height;
+                
+                // First pass: coverage bounding box
+                s32 minX = std::numeric_limits<s32>::max(), minY = std::numeric_limits<s32>::max();
+                s32 maxX = std::numeric_limits<s32>::min(), maxY = std::numeric_limits<s32>::min();
+                walkGlyphs(text, fontSize, monospace, [&](const FontManager::Glyph* glyph, s32 penX, s32 penY) {
+                    minX = std::min(minX, penX + glyph->bounds[0]);
+                    minY = std::min(minY, penY + glyph->bounds[1]);
+                    maxX = std::max(maxX, penX + glyph->bounds[0] + glyph->width);
+                    maxY = std::max(maxY, penY + glyph->bounds[1] + glyph->height);
+                });
+                
+                if (minX >= maxX || minY >= maxY)
+                    return sprite;
+                
+                sprite->offsetX = minX;
+                sprite->offsetY = minY;
+                sprite->width = maxX - minX;
+                sprite->height = maxY - minY;
+                sprite->coverage.assign((static_cast<size_t>(sprite->width) * sprite->height + 1) / 2, 0);
+                
+                // Second pass: composite glyph coverage; overlapping edges accumulate the same way
+                // sequential renderGlyph calls would ("over" operator in 4-bit precision)
+                walkGlyphs(text, fontSize, monospace, [&](const FontManager::Glyph* glyph, s32 penX, s32 penY) {
+                    const s32 originX = penX + glyph->bounds[0] - minX;
+                    const s32 originY = penY + glyph->bounds[1] - minY;
+                    const u8* bmpPtr = glyph->glyphBmp;
+                    
+                    for (s32 gy = 0; gy < glyph->height; ++gy, bmpPtr += glyph->width) {
+                        size_t index = static_cast<size_t>(originY + gy) * sprite->width + originX;
+                        for (s32 gx = 0; gx < glyph->width; ++gx, ++index) {
+                            const u8 alpha = bmpPtr[gx] >> 4;
+                            if (!alpha) continue;
+                            
+                            u8& packed = sprite->coverage[index >> 1];
+                            const u8 shift = (index & 1) ? 0 : 4;
+                            const u8 prev = (packed >> shift) & 0x0F;
+                            const u8 combined = (alpha == 0xF) ? 0xF : static_cast<u8>(alpha + ((prev * (0xF - alpha)) >> 4));
+                            packed = static_cast<u8>((packed & ~(0x0F << shift)) | (combined << shift));
+                        }
+                    }
+                });
+                
+                const Sprite& built = *sprite;
+                sprite->runs.build(sprite->width, sprite->height, [&built](s32 x, s32 y) {
+                    return built.alphaAt(x, y);
+                });
+                
+                return sprite;
+            }
+        };
+        
+        // Updated thread-safe calculateStringWidth function
+        static float calculateStringWidth(const std::string& originalString, const float fontSize, const bool monospace = false) {
+            if (originalString.empty() || !FontManager::isInitialized()) {
+                return 0.0f;
+            }
+            
+            // Convert fontSize to u32 to match drawString behavior
+            const auto layout = TextLayoutCache::get(getTranslatedText(originalString), static_cast<u32>(fontSize), monospace);
+            return static_cast<float>(layout->width);
+        }
+
+        static std::pair<int, int> getUnderscanPixels();
+        
+        /**
+         * @brief Persistent worker threads for the multithreaded draw paths
+         * @note Workers are started once with the renderer and park on a condition variable between jobs,
+         *       so large draws no longer create and join threads every frame. The submitting thread runs
+         *       chunks as well; with no workers, or when called from inside a running job, parallelFor simply
+         *       runs inline. Only the render thread submits.
+         */
+        class RenderWorkerPool {
+        public:
+            RenderWorkerPool() = default;
+            RenderWorkerPool(const RenderWorkerPool&) = delete;
+            RenderWorkerPool& operator=(const RenderWorkerPool&) = delete;
+            
+            ~RenderWorkerPool() {
+                this->stop();
+            }
+            
+            /**
+             * @brief Starts the workers
+             *
+             * @param threadCount Total threads working on a job, including the submitting one
+             */
+            void start(unsigned threadCount) {
+                if (!this->m_workers.empty() || threadCount <= 1)
+                    return;
+                
+                this->m_stopping = false;
+                this->m_workers.reserve(threadCount - 1);
+                for (unsigned i = 1; i < threadCount; ++i)
+                    this->m_workers.emplace_back(&RenderWorkerPool::workerLoop, this);
+            }
+            
+            /**
+             * @brief Wakes and joins all workers
+             */
+            void stop() {
+                if (this->m_workers.empty())
+                    return;
+                
+                {
+                    std::lock_guard<std::mutex> lock(this->m_mutex);
+                    this->m_stopping = true;
+                }
+                this->m_wake.notify_all();
+                
+                for (auto& worker : this->m_workers)
+                    worker.join();
+                this->m_workers.clear();
+            }
+            
+            /**
+             * @brief Number of threads a job is spread over, including the submitting one
+             */
+            inline unsigned size() const {
+                return static_cast<unsigned>(this->m_workers.size()) + 1;
+            }
+            
+            /**
+             * @brief Runs fn over [begin, end) in chunks of chunkSize rows and returns once every chunk is done
+             *
+             * @param begin First row
+             * @param end One past the last row
+             * @param chunkSize Rows handed out per fetch
+             * @param fn Callable (s32 chunkBegin, s32 chunkEnd)
+             */
+            template<typename Fn>
+            void parallelFor(const s32 begin, const s32 end, const s32 chunkSize, Fn&& fn) {
+                if (begin >= end)
+                    return;
+                
+                if (this->m_workers.empty() || s_inJob || chunkSize >= end - begin) {
+                    fn(begin, end);
+                    return;
+                }
+                
+                {
+                    std::lock_guard<std::mutex> lock(this->m_mutex);
+                    this->m_context = static_cast<void*>(std::addressof(fn));
+                    this->m_invoke = [](void* context, s32 chunkBegin, s32 chunkEnd) {
+                        (*static_cast<std::remove_reference_t<Fn>*>(context))(chunkBegin, chunkEnd);
+                    };
+                    this->m_next.store(begin, std::memory_order_relaxed);
+                    this->m_end = end;
+                    this->m_chunkSize = std::max<s32>(1, chunkSize);
+                    this->m_pending = static_cast<unsigned>(this->m_workers.size());
+                    ++this->m_generation;
+                }
+                this->m_wake.notify_all();
+                
+                s_inJob = true;
+                this->runChunks();
+                s_inJob = false;
+                
+                std::unique_lock<std::mutex> lock(this->m_mutex);
+                this->m_done.wait(lock, [this] { return this->m_pending == 0; });
+            }
+            
+        private:
+            std::vector<std::thread> m_workers;
+            std::mutex m_mutex;
+            std::condition_variable m_wake, m_done;
+            
+            void (*m_invoke)(void*, s32, s32) = nullptr;
+            void* m_context = nullptr;
+            std::atomic<s32> m_next{0};
+            s32 m_end = 0;
+            s32 m_chunkSize = 1;
+            unsigned m_pending = 0;
+            u64 m_generation = 0;
+            bool m_stopping = false;
+            
+            // Set on threads that are executing chunks, so nested parallel draws run inline
+            inline static thread_local bool s_inJob = false;
+            
+            inline void runChunks() {
+                s32 chunkBegin;
+                while ((chunkBegin = this->m_next.fetch_add(this->m_chunkSize, std::memory_order_relaxed)) < this->m_end)
+                    this->m_invoke(this->m_context, chunkBegin, std::min(chunkBegin + this->m_chunkSize, this->m_end));
+            }
+            
+            void workerLoop() {
+                u64 seenGeneration = 0;
+                s_inJob = true;
+                
+                while (true) {
+                    {
+                        std::unique_lock<std::mutex> lock(this->m_mutex);
+                        this->m_wake.wait(lock, [&] { return this->m_stopping || this->m_generation != seenGeneration; });
+                        if (this->m_stopping)
+                            return;
+                        seenGeneration = this->m_generation;
+                    }
+                    
+                    this->runChunks();
+                    
+                    {
+                        std::lock_guard<std::mutex> lock(this->m_mutex);
+                        if (--this->m_pending == 0)
+                            this->m_done.notify_one();
+                    }
+                }
+            }
+        };
+        
+        /**
+         * @brief Per-frame list of recorded draw commands
+         * @note Each command stores the rows it may touch, the clip (framebuffer and scissor) that was active
+         *       when it was recorded and a callable that issues the original draw. Callables and copied data
+         *       live in a bump arena that is reused from frame to frame, so steady-state recording doesn't allocate.
+         */
+        class DisplayList {
+        public:
+            struct Command {
+                s32 y0, y1;
+                ClipRect clip;
+                u64 hash;
+                void (*invoke)(void* payload, Renderer& renderer);
+                void (*destroy)(void* payload);
+                void* payload;
+            };
+            
+            DisplayList() = default;
+            DisplayList(const DisplayList&) = delete;
+            DisplayList& operator=(const DisplayList&) = delete;
+            
+            ~DisplayList() {
+                this->clear();
+            }
+            
+            /**
+             * @brief Appends a command
+             *
+             * @param y0 First row the command may touch
+             * @param y1 One past the last row
+             * @param clip Clip active at record time
+             * @param hash Hash of everything that affects the pixels the command produces, see hash()
+             * @param fn Callable (Renderer&) that performs the draw
+             */
+            template<typename Fn>
+            void record(const s32 y0, const s32 y1, const ClipRect& clip, const u64 hash, Fn&& fn) {
+                using Payload = std::decay_t<Fn>;
+                
+                void* payload = this->allocate(sizeof(Payload), alignof(Payload));
+                new (payload) Payload(std::forward<Fn>(fn));
+                
+                this->m_commands.push_back({
+                    y0, y1, clip, hashValue(hash, clip),
+                    &DisplayList::invokePayload<Payload>,
+                    std::is_trivially_destructible_v<Payload> ? nullptr : &DisplayList::destroyPayload<Payload>,
+                    payload
+                });
+            }
+            
+            /**
+             * @brief Copies data into the arena so it stays valid until the list is cleared
+             *
+             * @param data Source
+             * @param size Size in bytes
+             * @return Arena copy
+             */
+            const u8* copy(const void* data, const size_t size) {
+                u8* dst = static_cast<u8*>(this->allocate(size, alignof(u64)));
+                std::memcpy(dst, data, size);
+                return dst;
+            }
+            
+            /**
+             * @brief Hashes a command's name and arguments for frame-to-frame change detection
+             */
+            template<typename... Args>
+            static u64 hash(const std::string_view name, const Args&... args) {
+                u64 hash = hashValue(0xcbf29ce484222325ULL, name);
+                ((hash = hashValue(hash, args)), ...);
+                return hash;
+            }
+            
+            /**
+             * @brief Folds a value into a hash
+             */
+            static inline u64 combine(const u64 hash, const u64 value) {
+                return hash ^ (value + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2));
+            }
+            
+            inline const std::vector<Command>& commands() const {
+                return this->m_commands;
+            }
+            
+            inline bool empty() const {
+                return this->m_commands.empty();
+            }
+            
+            /**
+             * @brief Destroys all commands, keeping the arena blocks for the next frame
+             */
+            void clear() {
+                for (const auto& command : this->m_commands) {
+                    if (command.destroy)
+                        command.destroy(command.payload);
                 }
-                return key;
+                this->m_commands.clear();
+                this->m_blockIndex = 0;
+                this->m_blockUsed = 0;
             }
             
-            // Cleanup old entries when cache gets too large
-            static void cleanupOldEntries() {
-                if (s_sharedGlyphCache.size() <= CLEANUP_THRESHOLD) return;
-                
-                // Simple cleanup: remove oldest entries
-                // In a real implementation, you might want LRU or other strategies
-                size_t toRemove = s_sharedGlyphCache.size() - CLEANUP_THRESHOLD;
-                auto it = s_sharedGlyphCache.begin();
-                for (size_t i = 0; i < toRemove && it != s_sharedGlyphCache.end(); ++i) {
-                    it = s_sharedGlyphCache.erase(it);
+        private:
+            static constexpr size_t BlockSize = 16 * 1024;
+            
+            struct Block {
+                std::unique_ptr<u8[]> data;
+                size_t size;
+            };
+            
+            std::vector<Command> m_commands;
+            std::vector<Block> m_blocks;
+            size_t m_blockIndex = 0;
+            size_t m_blockUsed = 0;
+            
+            template<typename T>
+            static inline u64 hashValue(const u64 hash, const T& value) {
+                if constexpr (std::is_floating_point_v<T>) {
+                    double widened = value;
+                    u64 bits;
+                    std::memcpy(&bits, &widened, sizeof(bits));
+                    return combine(hash, bits);
+                } else if constexpr (std::is_pointer_v<T>) {
+                    return combine(hash, reinterpret_cast<uintptr_t>(value));
+                } else {
+                    static_assert(std::is_integral_v<T> || std::is_enum_v<T>, "Unsupported display list hash argument");
+                    return combine(hash, static_cast<u64>(value));
                 }
             }
             
-        public:
-            static void initializeFonts(stbtt_fontinfo* stdFont, stbtt_fontinfo* localFont, 
-                                      stbtt_fontinfo* extFont, bool hasLocalFont) {
-                std::lock_guard<std::mutex> initLock(s_initMutex);
-                std::unique_lock<std::shared_mutex> cacheLock(s_cacheMutex);
-                
-                s_stdFont = stdFont;
-                s_localFont = localFont;
-                s_extFont = extFont;
-                s_hasLocalFont = hasLocalFont;
-                s_initialized = true;
+            static inline u64 hashValue(const u64 hash, const std::string_view value) {
+                return combine(hash, std::hash<std::string_view>{}(value));
             }
             
-            static stbtt_fontinfo* selectFontForCharacter(u32 character) {
-                std::shared_lock<std::shared_mutex> lock(s_cacheMutex);
-                
-                if (!s_initialized) return nullptr;
-                
-                if (stbtt_FindGlyphIndex(s_extFont, character)) {
-                    return s_extFont;
-                } else if (s_hasLocalFont && stbtt_FindGlyphIndex(s_localFont, character) != 0) {
-                    return s_localFont;
-                }
-                return s_stdFont;
+            static inline u64 hashValue(const u64 hash, const std::string& value) {
+                return hashValue(hash, std::string_view(value));
             }
             
-            static Glyph* getOrCreateGlyph(u32 character, bool monospace, u32 fontSize) {
-                const u64 key = generateCacheKey(character, monospace, fontSize);
-                
-                // First, try to find existing glyph with shared lock
-                {
-                    std::shared_lock<std::shared_mutex> readLock(s_cacheMutex);
-                    
-                    if (!s_initialized) return nullptr;
-                    
-                    auto it = s_sharedGlyphCache.find(key);
-                    if (it != s_sharedGlyphCache.end()) {
-                        return it->second.get();
-                    }
-                }
-                
-                // Glyph not found, need to create it with exclusive lock
-                std::unique_lock<std::shared_mutex> writeLock(s_cacheMutex);
-                
-                if (!s_initialized) return nullptr;
-                
-                // Double-check pattern
-                auto it = s_sharedGlyphCache.find(key);
-                if (it != s_sharedGlyphCache.end()) {
-                    return it->second.get();
-                }
-                
-                // Check cache size and cleanup if needed
-                if (s_sharedGlyphCache.size() >= MAX_CACHE_SIZE) {
-                    cleanupOldEntries();
-                }
-                
-                // Create new glyph
-                auto glyph = std::make_unique<Glyph>();
-                glyph->currFont = selectFontForCharacterUnsafe(character);
-                if (!glyph->currFont) {
-                    return nullptr;
-                }
-                
-                glyph->currFontSize = stbtt_ScaleForPixelHeight(glyph->currFont, fontSize);
-                
-                stbtt_GetCodepointBitmapBoxSubpixel(glyph->currFont, character, 
-                    glyph->currFontSize, glyph->currFontSize, 0, 0, 
-                    &glyph->bounds[0], &glyph->bounds[1], &glyph->bounds[2], &glyph->bounds[3]);
-                
-                s32 yAdvance = 0;
-                stbtt_GetCodepointHMetrics(glyph->currFont, monospace ? 'W' : character, 
-                                          &glyph->xAdvance, &yAdvance);
-                
-                glyph->glyphBmp = stbtt_GetCodepointBitmap(glyph->currFont, 
-                    glyph->currFontSize, glyph->currFontSize, character, 
-                    &glyph->width, &glyph->height, nullptr, nullptr);
-                
-                Glyph* glyphPtr = glyph.get();
-                s_sharedGlyphCache[key] = std::move(glyph);
-                
-                return glyphPtr;
+            static inline u64 hashValue(const u64 hash, const Color& value) {
+                return combine(hash, value.rgba);
             }
             
-            static void clearCache() {
-                std::unique_lock<std::shared_mutex> cacheLock(s_cacheMutex);
-                s_sharedGlyphCache.clear(); // unique_ptr will handle cleanup
+            static inline u64 hashValue(const u64 hash, const ClipRect& value) {
+                return combine(combine(combine(combine(hash, value.x0), value.y0), value.x1), value.y1);
             }
             
-            static void cleanup() {
-                std::lock_guard<std::mutex> initLock(s_initMutex);
-                std::unique_lock<std::shared_mutex> cacheLock(s_cacheMutex);
-                
-                s_sharedGlyphCache.clear();
-                s_initialized = false;
-                s_stdFont = nullptr;
-                s_localFont = nullptr;
-                s_extFont = nullptr;
-                s_hasLocalFont = false;
+            static inline u64 hashValue(const u64 hash, const std::vector<std::string>& values) {
+                u64 result = combine(hash, values.size());
+                for (const auto& value : values)
+                    result = hashValue(result, value);
+                return result;
             }
             
-            static size_t getCacheSize() {
-                std::shared_lock<std::shared_mutex> lock(s_cacheMutex);
-                return s_sharedGlyphCache.size();
+            template<typename Payload>
+            static void invokePayload(void* payload, Renderer& renderer) {
+                (*static_cast<Payload*>(payload))(renderer);
             }
             
-            static bool isInitialized() {
-                std::shared_lock<std::shared_mutex> lock(s_cacheMutex);
-                return s_initialized;
+            template<typename Payload>
+            static void destroyPayload(void* payload) {
+                static_cast<Payload*>(payload)->~Payload();
             }
             
-            // Add memory usage monitoring
-            static size_t getMemoryUsage() {
-                std::shared_lock<std::shared_mutex> lock(s_cacheMutex);
-                size_t totalMemory = 0;
-                for (const auto& pair : s_sharedGlyphCache) {
-                    const auto& glyph = pair.second;
-                    if (glyph && glyph->glyphBmp) {
-                        totalMemory += glyph->width * glyph->height; // Approximate bitmap size
+            void* allocate(const size_t size, const size_t alignment) {
+                size_t offset;
+                while (this->m_blockIndex < this->m_blocks.size()) {
+                    offset = (this->m_blockUsed + alignment - 1) & ~(alignment - 1);
+                    if (offset + size <= this->m_blocks[this->m_blockIndex].size) {
+                        this->m_blockUsed = offset + size;
+                        return this->m_blocks[this->m_blockIndex].data.get() + offset;
                     }
+                    ++this->m_blockIndex;
+                    this->m_blockUsed = 0;
                 }
-                return totalMemory;
-            }
-            
-        private:
-            static stbtt_fontinfo* selectFontForCharacterUnsafe(u32 character) {
-                if (!s_initialized) return nullptr;
                 
-                if (stbtt_FindGlyphIndex(s_extFont, character)) {
-                    return s_extFont;
-                } else if (s_hasLocalFont && stbtt_FindGlyphIndex(s_localFont, character) != 0) {
-                    return s_localFont;
-                }
-                return s_stdFont;
+                // Out of blocks; oversized payloads (copied bitmaps) get a block of their own.
+                // Blocks come from operator new[] and are aligned for any fundamental type.
+                const size_t blockSize = std::max(BlockSize, size);
+                this->m_blocks.push_back({ std::make_unique<u8[]>(blockSize), blockSize });
+                this->m_blockIndex = this->m_blocks.size() - 1;
+                this->m_blockUsed = size;
+                return this->m_blocks.back().data.get();
             }
         };
         
-        // Static member definitions
-       //std::shared_mutex FontManager::s_cacheMutex;
-       //std::mutex FontManager::s_initMutex;
-       //std::unordered_map<u64, std::unique_ptr<FontManager::Glyph>> FontManager::s_sharedGlyphCache;
-       //stbtt_fontinfo* FontManager::s_stdFont = nullptr;
-       //stbtt_fontinfo* FontManager::s_localFont = nullptr;
-       //stbtt_fontinfo* FontManager::s_extFont = nullptr;
-       //bool FontManager::s_hasLocalFont = false;
-       //bool FontManager::s_initialized = false;
-        
-        // Updated thread-safe calculateStringWidth function
-        static float calculateStringWidth(const std::string& originalString, const float fontSize, const bool monospace = false) {
-            if (originalString.empty() || !FontManager::isInitialized()) {
-                return 0.0f;
+        /**
+         * @brief In-memory RGBA4444 framebuffer used by the renderer's headless mode
+         * @note Buffers use the same block-linear layout as the libnx framebuffer (height padded to
+         *       whole 128 row blocks), so every draw call goes through the regular swizzled addressing.
+         *       Lets the drawing code run without a VI layer, e.g. for profiling. The libnx headers are
+         *       still required; host builds have to supply them.
+         */
+        class HeadlessFramebuffer {
+        public:
+            /**
+             * @brief Allocates the framebuffers
+             *
+             * @param width Width in pixels (multiple of 32)
+             * @param height Height in pixels
+             * @param count Number of buffers to flip between
+             */
+            void create(u32 width, u32 height, u32 count = 2) {
+                m_width = width;
+                m_height = height;
+                m_size = static_cast<size_t>(width) * ((height + 127) & ~127u) * sizeof(u16);
+                m_count = std::max<u32>(count, 1);
+                m_slot = 0;
+                m_buffer.assign(m_size / sizeof(u16) * m_count, 0);
             }
             
-            // Thread-safe translation cache access
-            std::string text;
-            #ifdef UI_OVERRIDE_PATH
-            {
-                std::shared_lock<std::shared_mutex> readLock(s_translationCacheMutex);
-                auto translatedIt = ult::translationCache.find(originalString);
-                if (translatedIt != ult::translationCache.end()) {
-                    text = translatedIt->second;
-                } else {
-                    // Need to upgrade to write lock
-                    readLock.unlock();
-                    std::unique_lock<std::shared_mutex> writeLock(s_translationCacheMutex);
-                    
-                    // Double-check pattern
-                    translatedIt = ult::translationCache.find(originalString);
-                    if (translatedIt != ult::translationCache.end()) {
-                        text = translatedIt->second;
-                    } else {
-                        ult::translationCache[originalString] = originalString;
-                        text = originalString;
-                    }
-                }
+            void close() {
+                m_buffer.clear();
+                m_buffer.shrink_to_fit();
+                m_size = 0;
             }
-            #else
-            text = originalString;
-            #endif
             
-            // CRITICAL: Use the same data types as drawString
-            s32 maxWidth = 0;
-            s32 currentLineWidth = 0;
-            ssize_t codepointWidth;
-            u32 currCharacter = 0;
+            inline void* begin() {
+                return slotData(m_slot);
+            }
             
-            // Convert fontSize to u32 to match drawString behavior
-            const u32 fontSizeInt = static_cast<u32>(fontSize);
+            inline void end() {
+                m_lastPresented = m_slot;
+                m_slot = (m_slot + 1) % m_count;
+            }
+            
+            inline void* slotData(u32 slot) {
+                return m_buffer.data() + slot * (m_size / sizeof(u16));
+            }
             
-            auto itStrEnd = text.cend();
-            auto itStr = text.cbegin();
+            inline size_t size() const { return m_size; }
+            inline u32 count() const { return m_count; }
+            inline u32 currentSlot() const { return m_slot; }
+            inline u32 lastPresentedSlot() const { return m_lastPresented; }
             
-            // Fast ASCII check
-            bool isAsciiOnly = true;
-            for (unsigned char c : text) {
-                if (c > 127) {
-                    isAsciiOnly = false;
-                    break;
+            /**
+             * @brief Writes a buffer as a binary PPM, composited over a background color
+             *
+             * @param path Output path
+             * @param slot Buffer slot
+             * @param background Background the frame is composited onto (the game image on hardware)
+             * @return true on success
+             */
+            bool writePPM(const std::string& path, u32 slot, Color background = {0x0, 0x0, 0x0, 0xF});
+            
+        private:
+            std::vector<u16> m_buffer;
+            size_t m_size = 0;
+            u32 m_width = 0, m_height = 0;
+            u32 m_count = 1, m_slot = 0, m_lastPresented = 0;
+            
+            static inline u8 compositeChannel(u8 src, u8 dst, u8 alpha) {
+                return static_cast<u8>(((src * alpha + dst * (0xF - alpha)) * 0x11) / 0xF);
+            }
+        };
+
+        /**
+         * @brief RGBA4444 blend kernels working on contiguous framebuffer pixels
+         * @note Pixels are packed as r | g << 4 | b << 8 | a << 12 (see Color). In the swizzled framebuffer every
+         *       8 horizontally adjacent pixels starting at x % 8 == 0 are contiguous, so the vector kernels take
+         *       exactly one such group (NEON on hardware, SSE2 for host builds). The scalar versions are the
+         *       reference and handle partial groups. Channel inputs are 4-bit; all products fit in 8 bits.
+         */
+        namespace blend {
+            
+            inline u16 pack(u16 r, u16 g, u16 b, u16 a) {
+                return r | (g << 4) | (b << 8) | (a << 12);
+            }
+            
+            /**
+             * @brief Source blend with per-pixel channels, keeping destination alpha (setPixelBlendSrc)
+             * @note Pixels with alpha 0 are left untouched.
+             */
+            inline void srcChannelsScalar(u16* dst, s32 count, const u8* r, const u8* g, const u8* b, const u8* a) {
+                for (s32 i = 0; i < count; ++i) {
+                    const u16 alpha = a[i];
+                    if (!alpha) continue;
+                    const u16 inv = alpha ^ 0xF;
+                    const u16 px = dst[i];
+                    dst[i] = pack(((r[i] * alpha + (px & 0xF) * inv) >> 4) & 0xF,
+                                  ((g[i] * alpha + ((px >> 4) & 0xF) * inv) >> 4) & 0xF,
+                                  ((b[i] * alpha + ((px >> 8) & 0xF) * inv) >> 4) & 0xF,
+                                  px >> 12);
                 }
             }
             
-            while (itStr != itStrEnd) {
-                // Decode UTF-8 codepoint
-                if (isAsciiOnly) {
-                    currCharacter = static_cast<u32>(*itStr);
-                    codepointWidth = 1;
-                } else {
-                    codepointWidth = decode_utf8(&currCharacter, reinterpret_cast<const u8*>(&(*itStr)));
-                    if (codepointWidth <= 0) break;
+            /**
+             * @brief Destination blend with per-pixel channels (setPixelBlendDst)
+             * @note Pixels with alpha 0 are left untouched.
+             */
+            inline void dstChannelsScalar(u16* dst, s32 count, const u8* r, const u8* g, const u8* b, const u8* a) {
+                for (s32 i = 0; i < count; ++i) {
+                    const u16 alpha = a[i];
+                    if (!alpha) continue;
+                    const u16 inv = alpha ^ 0xF;
+                    const u16 px = dst[i];
+                    dst[i] = pack(((r[i] * alpha + (px & 0xF) * inv) >> 4) & 0xF,
+                                  ((g[i] * alpha + ((px >> 4) & 0xF) * inv) >> 4) & 0xF,
+                                  ((b[i] * alpha + ((px >> 8) & 0xF) * inv) >> 4) & 0xF,
+                                  (alpha + (((px >> 12) * (0xF - alpha)) >> 4)) & 0xF);
+                }
+            }
+            
+            /**
+             * @brief Destination blend of one color over a run (setPixelBlendDst, alpha 0 included)
+             */
+            inline void dstUniformScalar(u16* dst, s32 count, const Color& color) {
+                const u16 alpha = color.a;
+                const u16 inv = alpha ^ 0xF;
+                const u16 r = color.r * alpha, g = color.g * alpha, b = color.b * alpha;
+                for (s32 i = 0; i < count; ++i) {
+                    const u16 px = dst[i];
+                    dst[i] = pack(((r + (px & 0xF) * inv) >> 4) & 0xF,
+                                  ((g + ((px >> 4) & 0xF) * inv) >> 4) & 0xF,
+                                  ((b + ((px >> 8) & 0xF) * inv) >> 4) & 0xF,
+                                  (alpha + (((px >> 12) * (0xF - alpha)) >> 4)) & 0xF);
                 }
+            }
+            
+            /**
+             * @brief Source blend of a preprocessed RGBA4444 bitmap run (two bytes per pixel: r << 4 | g, b << 4 | a)
+             * @note Pixels with alpha 0 are left untouched, destination alpha is kept.
+             */
+            inline void srcBitmapScalar(u16* dst, s32 count, const u8* src) {
+                for (s32 i = 0; i < count; ++i, src += 2) {
+                    const u16 alpha = src[1] & 0xF;
+                    if (!alpha) continue;
+                    const u16 inv = alpha ^ 0xF;
+                    const u16 px = dst[i];
+                    dst[i] = pack((((src[0] >> 4) * alpha + (px & 0xF) * inv) >> 4) & 0xF,
+                                  (((src[0] & 0xF) * alpha + ((px >> 4) & 0xF) * inv) >> 4) & 0xF,
+                                  (((src[1] >> 4) * alpha + ((px >> 8) & 0xF) * inv) >> 4) & 0xF,
+                                  px >> 12);
+                }
+            }
+            
+        #if defined(__ARM_NEON)
+            // Splits 8 packed pixels into 8-bit channel lanes
+            inline void unpack8(uint16x8_t px, uint8x8_t& r, uint8x8_t& g, uint8x8_t& b, uint8x8_t& a) {
+                const uint16x8_t mask = vdupq_n_u16(0xF);
+                r = vmovn_u16(vandq_u16(px, mask));
+                g = vmovn_u16(vandq_u16(vshrq_n_u16(px, 4), mask));
+                b = vmovn_u16(vandq_u16(vshrq_n_u16(px, 8), mask));
+                a = vmovn_u16(vshrq_n_u16(px, 12));
+            }
+            
+            inline uint16x8_t pack8(uint8x8_t r, uint8x8_t g, uint8x8_t b, uint8x8_t a) {
+                return vorrq_u16(vorrq_u16(vmovl_u8(r), vshlq_n_u16(vmovl_u8(g), 4)),
+                                 vorrq_u16(vshlq_n_u16(vmovl_u8(b), 8), vshlq_n_u16(vmovl_u8(a), 12)));
+            }
+            
+            // (src * alpha + dst * inv) >> 4 in 8-bit lanes (at most 15 * 15)
+            inline uint8x8_t mix8(uint8x8_t src, uint8x8_t dst, uint8x8_t alpha, uint8x8_t inv) {
+                return vshr_n_u8(vmla_u8(vmul_u8(src, alpha), dst, inv), 4);
+            }
+            
+            inline void srcChannels8(u16* dst, const u8* r, const u8* g, const u8* b, const u8* a) {
+                const uint16x8_t px = vld1q_u16(dst);
+                uint8x8_t dr, dg, db, da;
+                unpack8(px, dr, dg, db, da);
+                const uint8x8_t alpha = vld1_u8(a);
+                const uint8x8_t inv = veor_u8(alpha, vdup_n_u8(0xF));
+                const uint16x8_t out = pack8(mix8(vld1_u8(r), dr, alpha, inv), mix8(vld1_u8(g), dg, alpha, inv),
+                                             mix8(vld1_u8(b), db, alpha, inv), da);
+                vst1q_u16(dst, vbslq_u16(vceqq_u16(vmovl_u8(alpha), vdupq_n_u16(0)), px, out));
+            }
+            
+            inline void dstChannels8(u16* dst, const u8* r, const u8* g, const u8* b, const u8* a) {
+                const uint16x8_t px = vld1q_u16(dst);
+                uint8x8_t dr, dg, db, da;
+                unpack8(px, dr, dg, db, da);
+                const uint8x8_t alpha = vld1_u8(a);
+                const uint8x8_t inv = veor_u8(alpha, vdup_n_u8(0xF));
+                const uint8x8_t outAlpha = vadd_u8(alpha, vshr_n_u8(vmul_u8(da, inv), 4));
+                const uint16x8_t out = pack8(mix8(vld1_u8(r), dr, alpha, inv), mix8(vld1_u8(g), dg, alpha, inv),
+                                             mix8(vld1_u8(b), db, alpha, inv), outAlpha);
+                vst1q_u16(dst, vbslq_u16(vceqq_u16(vmovl_u8(alpha), vdupq_n_u16(0)), px, out));
+            }
+            
+            inline void dstUniform8(u16* dst, const Color& color) {
+                uint8x8_t dr, dg, db, da;
+                unpack8(vld1q_u16(dst), dr, dg, db, da);
+                const uint8x8_t alpha = vdup_n_u8(color.a);
+                const uint8x8_t inv = vdup_n_u8(color.a ^ 0xF);
+                const uint8x8_t outAlpha = vadd_u8(alpha, vshr_n_u8(vmul_u8(da, inv), 4));
+                vst1q_u16(dst, pack8(mix8(vdup_n_u8(color.r), dr, alpha, inv), mix8(vdup_n_u8(color.g), dg, alpha, inv),
+                                     mix8(vdup_n_u8(color.b), db, alpha, inv), outAlpha));
+            }
+            
+            inline void srcBitmap8(u16* dst, const u8* src) {
+                const uint16x8_t px = vld1q_u16(dst);
+                uint8x8_t dr, dg, db, da;
+                unpack8(px, dr, dg, db, da);
+                const uint8x8x2_t packed = vld2_u8(src);
+                const uint8x8_t mask = vdup_n_u8(0xF);
+                const uint8x8_t alpha = vand_u8(packed.val[1], mask);
+                const uint8x8_t inv = veor_u8(alpha, mask);
+                const uint16x8_t out = pack8(mix8(vshr_n_u8(packed.val[0], 4), dr, alpha, inv),
+                                             mix8(vand_u8(packed.val[0], mask), dg, alpha, inv),
+                                             mix8(vshr_n_u8(packed.val[1], 4), db, alpha, inv), da);
+                vst1q_u16(dst, vbslq_u16(vceqq_u16(vmovl_u8(alpha), vdupq_n_u16(0)), px, out));
+            }
+        #elif defined(__SSE2__)
+            inline __m128i load8(const u8* values) {
+                return _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(values)), _mm_setzero_si128());
+            }
+            
+            inline __m128i pack8(__m128i r, __m128i g, __m128i b, __m128i a) {
+                return _mm_or_si128(_mm_or_si128(r, _mm_slli_epi16(g, 4)), _mm_or_si128(_mm_slli_epi16(b, 8), _mm_slli_epi16(a, 12)));
+            }
+            
+            inline __m128i mix8(__m128i src, __m128i dst, __m128i alpha, __m128i inv) {
+                return _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(src, alpha), _mm_mullo_epi16(dst, inv)), 4);
+            }
+            
+            inline __m128i select8(__m128i alpha, __m128i px, __m128i out) {
+                const __m128i keep = _mm_cmpeq_epi16(alpha, _mm_setzero_si128());
+                return _mm_or_si128(_mm_and_si128(keep, px), _mm_andnot_si128(keep, out));
+            }
+            
+            template<bool DstAlpha>
+            inline void channels8(u16* dst, const u8* r, const u8* g, const u8* b, const u8* a) {
+                const __m128i mask = _mm_set1_epi16(0xF);
+                const __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst));
+                const __m128i da = _mm_srli_epi16(px, 12);
+                const __m128i alpha = load8(a);
+                const __m128i inv = _mm_xor_si128(alpha, mask);
+                const __m128i outAlpha = DstAlpha ? _mm_add_epi16(alpha, _mm_srli_epi16(_mm_mullo_epi16(da, inv), 4)) : da;
+                const __m128i out = pack8(mix8(load8(r), _mm_and_si128(px, mask), alpha, inv),
+                                          mix8(load8(g), _mm_and_si128(_mm_srli_epi16(px, 4), mask), alpha, inv),
+                                          mix8(load8(b), _mm_and_si128(_mm_srli_epi16(px, 8), mask), alpha, inv), outAlpha);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), select8(alpha, px, out));
+            }
+            
+            inline void srcChannels8(u16* dst, const u8* r, const u8* g, const u8* b, const u8* a) {
+                channels8<false>(dst, r, g, b, a);
+            }
+            
+            inline void dstChannels8(u16* dst, const u8* r, const u8* g, const u8* b, const u8* a) {
+                channels8<true>(dst, r, g, b, a);
+            }
+            
+            inline void dstUniform8(u16* dst, const Color& color) {
+                const __m128i mask = _mm_set1_epi16(0xF);
+                const __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst));
+                const __m128i alpha = _mm_set1_epi16(color.a);
+                const __m128i inv = _mm_set1_epi16(color.a ^ 0xF);
+                const __m128i outAlpha = _mm_add_epi16(alpha, _mm_srli_epi16(_mm_mullo_epi16(_mm_srli_epi16(px, 12), inv), 4));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst),
+                                 pack8(mix8(_mm_set1_epi16(color.r), _mm_and_si128(px, mask), alpha, inv),
+                                       mix8(_mm_set1_epi16(color.g), _mm_and_si128(_mm_srli_epi16(px, 4), mask), alpha, inv),
+                                       mix8(_mm_set1_epi16(color.b), _mm_and_si128(_mm_srli_epi16(px, 8), mask), alpha, inv), outAlpha));
+            }
+            
+            inline void srcBitmap8(u16* dst, const u8* src) {
+                const __m128i mask = _mm_set1_epi16(0xF);
+                const __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst));
+                const __m128i packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));  // byte0 | byte1 << 8 per pixel
+                const __m128i alpha = _mm_and_si128(_mm_srli_epi16(packed, 8), mask);
+                const __m128i inv = _mm_xor_si128(alpha, mask);
+                const __m128i out = pack8(mix8(_mm_and_si128(_mm_srli_epi16(packed, 4), mask), _mm_and_si128(px, mask), alpha, inv),
+                                          mix8(_mm_and_si128(packed, mask), _mm_and_si128(_mm_srli_epi16(px, 4), mask), alpha, inv),
+                                          mix8(_mm_and_si128(_mm_srli_epi16(packed, 12), mask), _mm_and_si128(_mm_srli_epi16(px, 8), mask), alpha, inv),
+                                          _mm_srli_epi16(px, 12));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), select8(alpha, px, out));
+            }
+        #else
+            inline void srcChannels8(u16* dst, const u8* r, const u8* g, const u8* b, const u8* a) { srcChannelsScalar(dst, 8, r, g, b, a); }
+            inline void dstChannels8(u16* dst, const u8* r, const u8* g, const u8* b, const u8* a) { dstChannelsScalar(dst, 8, r, g, b, a); }
+            inline void dstUniform8(u16* dst, const Color& color) { dstUniformScalar(dst, 8, color); }
+            inline void srcBitmap8(u16* dst, const u8* src) { srcBitmapScalar(dst, 8, src); }
+        #endif
+            
+            // Run dispatchers: vector kernel for every whole 8 pixel group, scalar for the rest. Swizzled
+            // framebuffers hand out single groups, the linear back buffer whole spans.
+            inline void srcChannels(u16* dst, s32 count, const u8* r, const u8* g, const u8* b, const u8* a) {
+                for (; count >= 8; count -= 8, dst += 8, r += 8, g += 8, b += 8, a += 8)
+                    srcChannels8(dst, r, g, b, a);
+                if (count > 0)
+                    srcChannelsScalar(dst, count, r, g, b, a);
+            }
+            
+            inline void dstChannels(u16* dst, s32 count, const u8* r, const u8* g, const u8* b, const u8* a) {
+                for (; count >= 8; count -= 8, dst += 8, r += 8, g += 8, b += 8, a += 8)
+                    dstChannels8(dst, r, g, b, a);
+                if (count > 0)
+                    dstChannelsScalar(dst, count, r, g, b, a);
+            }
+            
+            inline void dstUniform(u16* dst, s32 count, const Color& color) {
+                for (; count >= 8; count -= 8, dst += 8)
+                    dstUniform8(dst, color);
+                if (count > 0)
+                    dstUniformScalar(dst, count, color);
+            }
+            
+            inline void srcBitmap(u16* dst, s32 count, const u8* src) {
+                for (; count >= 8; count -= 8, dst += 8, src += 16)
+                    srcBitmap8(dst, src);
+                if (count > 0)
+                    srcBitmapScalar(dst, count, src);
+            }
+            
+            /**
+             * @brief Source blend of fully opaque pixels whose color channels were blended ahead of time
+             * @note rgb holds what srcBitmap would produce for alpha 15 (channel * 15 >> 4), alpha bits clear.
+             */
+            inline void srcOpaque(u16* dst, s32 count, const u16* rgb) {
+                for (s32 i = 0; i < count; ++i)
+                    dst[i] = (dst[i] & 0xF000) | rgb[i];
+            }
+        }
+        
+        /**
+         * @brief RGBA8888 bitmap converted once for repeated drawing with Renderer::drawSprite
+         * @note Every row is split into runs of opaque and translucent pixels; fully transparent pixels are
+         *       skipped without being touched. Opaque runs are stored pre-blended so drawing them is a masked
+         *       copy. Sprites are drawn by reference, so one must outlive the frame it was drawn in.
+         */
+        class Sprite {
+        public:
+            Sprite() = default;
+            
+            /**
+             * @brief Converts a bitmap
+             *
+             * @param w Bitmap width
+             * @param h Bitmap height
+             * @param bmp RGBA8888 pixels, row by row
+             */
+            Sprite(const s32 w, const s32 h, const u8* bmp) {
+                if (w <= 0 || h <= 0 || !bmp) return;
                 
-                itStr += codepointWidth;
+                this->m_width = w;
+                this->m_height = h;
+                this->m_pixels.resize(static_cast<size_t>(w) * h * 2);
+                this->m_opaque.resize(static_cast<size_t>(w) * h);
+                this->m_rowRuns.reserve(h + 1);
                 
-                // Handle newlines
-                if (currCharacter == '\n') {
-                    maxWidth = std::max(currentLineWidth, maxWidth);
-                    currentLineWidth = 0;
-                    continue;
-                }
+                ult::convertRGBA8888ToRGBA4444(bmp, this->m_pixels.data(), static_cast<size_t>(w) * h);
                 
-                // Use u32 fontSize to match drawString - now thread-safe
-                FontManager::Glyph* glyph = FontManager::getOrCreateGlyph(currCharacter, monospace, fontSizeInt);
-                if (!glyph) continue;
+                for (s32 row = 0; row < h; ++row) {
+                    this->m_rowRuns.push_back(static_cast<u32>(this->m_runs.size()));
+                    const u8* const pixels = this->m_pixels.data() + static_cast<size_t>(row) * w * 2;
+                    u16* const opaque = this->m_opaque.data() + static_cast<size_t>(row) * w;
+                    
+                    for (s32 x = 0; x < w; ) {
+                        const u8 alpha = pixels[x * 2 + 1] & 0xF;
+                        s32 end = x + 1;
+                        while (end < w && ((pixels[end * 2 + 1] & 0xF) == 0xF) == (alpha == 0xF) &&
+                               ((pixels[end * 2 + 1] & 0xF) == 0) == (alpha == 0))
+                            ++end;
+                        
+                        if (alpha == 0xF) {
+                            for (s32 i = x; i < end; ++i) {
+                                opaque[i] = ((pixels[i * 2] >> 4) * 15 >> 4) |
+                                            (((pixels[i * 2] & 0xF) * 15 >> 4) << 4) |
+                                            (((pixels[i * 2 + 1] >> 4) * 15 >> 4) << 8);
+                            }
+                        }
+                        if (alpha != 0)
+                            this->m_runs.push_back({ static_cast<u16>(x), static_cast<u16>(end - x), alpha == 0xF });
+                        x = end;
+                    }
+                }
+                this->m_rowRuns.push_back(static_cast<u32>(this->m_runs.size()));
                 
-                // CRITICAL: Use the same calculation as drawString
-                currentLineWidth += static_cast<s32>(glyph->xAdvance * glyph->currFontSize);
+                this->m_hash = DisplayList::hash("sprite", w, h,
+                    std::string_view(reinterpret_cast<const char*>(this->m_pixels.data()), this->m_pixels.size()));
             }
             
-            // Final width calculation
-            maxWidth = std::max(currentLineWidth, maxWidth);
-            return static_cast<float>(maxWidth);
-        }
-
-        static std::pair<int, int> getUnderscanPixels();
+            inline s32 getWidth() const { return this->m_width; }
+            inline s32 getHeight() const { return this->m_height; }
+            inline bool empty() const { return this->m_pixels.empty(); }
+            
+        private:
+            friend class Renderer;
+            
+            struct Run {
+                u16 x, length;
+                bool opaque;
+            };
+            
+            s32 m_width = 0, m_height = 0;
+            u64 m_hash = 0;
+            std::vector<u8> m_pixels;       // RGBA4444 in the drawBitmapRGBA4444 byte order
+            std::vector<u16> m_opaque;      // Pre-blended color of opaque pixels
+            std::vector<Run> m_runs;
+            std::vector<u32> m_rowRuns;     // First run of every row, plus the end
+        };
+        
+        /**
+         * @brief Per-row spans of a rounded rectangle, relative to its top-left corner
+         * @note Built once per (width, height, radius) by Renderer::getRoundedRectMask. Every row also records how
+         *       much of the pixel just outside either end of its span the exact circle covers (0-15).
+         */
+        struct RoundedRectMask {
+            struct Row {
+                s32 start, end;
+                u8 leftCoverage, rightCoverage;
+            };
+            
+            s32 width = 0, height = 0, radius = 0;
+            std::vector<Row> rows;
+        };
 
         /**
          * @brief Manages the Tesla layer and draws raw data to the screen
@@ -1231,6 +3649,10 @@ namespace tsl {
             Renderer& operator=(Renderer&) = delete;
             
             friend class tsl::Overlay;
+            friend class HeadlessFramebuffer;
+            #if RENDER_BENCHMARK_DIRECTIVE
+            friend class tsl::bench::RenderBenchmark;
+            #endif
             
             /**
              * @brief Gets the renderer instance
@@ -1290,6 +3712,8 @@ namespace tsl {
                 if (offset != UINT32_MAX) [[likely]] {
                     Color* framebuffer = static_cast<Color*>(this->getCurrentFramebuffer());
                     framebuffer[offset] = color;
+                    if (this->m_linearTarget) [[unlikely]]
+                        this->markWritten(x, x + 1, y, y + 1);
                 }
             }
 
@@ -1342,35 +3766,10 @@ namespace tsl {
                                               const u8 red[16], const u8 green[16], 
                                               const u8 blue[16], const u8 alpha[16], 
                                               const s32 count) {
-                // All variables moved outside the loop
-                const u16* framebuffer = static_cast<const u16*>(this->getCurrentFramebuffer());
-                u32 offset;
-                u8 currentAlpha;
-                Color src = {0}, end = {0};
-                u32 currentX;
-                
-                for (s32 i = 0; i < count; ++i) {
-                    // Early exit for transparent pixels
-                    currentAlpha = alpha[i];
-                    if (currentAlpha == 0)
-                        continue;
-                    
-                    currentX = baseX + i;
-                    offset = this->getPixelOffset(currentX, baseY);
-                    if (offset == UINT32_MAX) [[unlikely]]
-                        continue;
-                    
-                    // Direct framebuffer access and color construction
-                    src = Color(framebuffer[offset]);
-                    
-                    // Direct member assignment instead of constructor
-                    end.r = blendColor(src.r, red[i], currentAlpha);
-                    end.g = blendColor(src.g, green[i], currentAlpha);
-                    end.b = blendColor(src.b, blue[i], currentAlpha);
-                    end.a = src.a;
-                    
-                    this->setPixel(currentX, baseY, end, offset);
-                }
+                this->forEachRowRun(baseX, baseX + count, baseY, [&](u16* dst, s32 x, s32 runLength) {
+                    const s32 i = x - baseX;
+                    blend::srcChannels(dst, runLength, red + i, green + i, blue + i, alpha + i);
+                });
             }
 
             
@@ -1405,43 +3804,95 @@ namespace tsl {
                 this->setPixel(x, y, end, offset);
             }
             
-            // Batch version for setPixelBlendDst
-            inline void setPixelBlendDstBatch(const u32 baseX, const u32 baseY, 
-                                              const u8 red[16], const u8 green[16], 
-                                              const u8 blue[16], const u8 alpha[16], 
-                                              const s32 count) {
-                // All variables moved outside the loop
-                const u16* framebuffer = static_cast<const u16*>(this->getCurrentFramebuffer());
-                u32 offset;
-                u8 currentAlpha;
-                u8 invAlpha;
-                Color src = {0}, end = {0};
-                u32 currentX;
+            // Batch version for setPixelBlendDst
+            inline void setPixelBlendDstBatch(const u32 baseX, const u32 baseY, 
+                                              const u8 red[16], const u8 green[16], 
+                                              const u8 blue[16], const u8 alpha[16], 
+                                              const s32 count) {
+                this->forEachRowRun(baseX, baseX + count, baseY, [&](u16* dst, s32 x, s32 runLength) {
+                    const s32 i = x - baseX;
+                    blend::dstChannels(dst, runLength, red + i, green + i, blue + i, alpha + i);
+                });
+            }
+            
+            /**
+             * @brief Walks the clipped part of a horizontal run in contiguous framebuffer groups
+             * @note The run is clipped once against the framebuffer and the active scissor; each group covers
+             *       up to 8 pixels that are adjacent in memory (x % 8 == 0 starts a new group). The linear back
+             *       buffer hands out the whole clipped run as one group and records it as damaged.
+             *
+             * @param x0 First x
+             * @param x1 One past the last x
+             * @param y Row
+             * @param fn Callable (u16* dst, s32 x, s32 runLength) invoked for each group
+             */
+            template<typename Fn>
+            inline void forEachRowRun(s32 x0, s32 x1, const s32 y, Fn&& fn) {
+                this->forEachRowRun(this->getClipRect(), x0, x1, y, std::forward<Fn>(fn));
+            }
+            
+            /**
+             * @brief Same as above with a clip rect the caller already resolved, for draws that emit many spans
+             *
+             * @param clip Drawable area from getClipRect()
+             * @param x0 First x
+             * @param x1 One past the last x
+             * @param y Row
+             * @param fn Callable (u16* dst, s32 x, s32 runLength) invoked for each group
+             */
+            template<typename Fn>
+            inline void forEachRowRun(const ClipRect& clip, s32 x0, s32 x1, const s32 y, Fn&& fn) {
+                if (y < clip.y0 || y >= clip.y1) return;
+                
+                x0 = std::max(x0, clip.x0);
+                x1 = std::min(x1, clip.x1);
+                if (x0 >= x1) return;
+                
+                u16* const row = static_cast<u16*>(this->getCurrentFramebuffer()) + this->getRowOffset(y);
+                if (this->m_linearTarget) {
+                    this->markWritten(x0, x1, y, y + 1);
+                    fn(row + x0, x0, x1 - x0);
+                    return;
+                }
                 
-                for (s32 i = 0; i < count; ++i) {
-                    // Early exit for transparent pixels
-                    currentAlpha = alpha[i];
-                    if (currentAlpha == 0)
-                        continue;
-                    
-                    currentX = baseX + i;
-                    offset = this->getPixelOffset(currentX, baseY);
-                    if (offset == UINT32_MAX) [[unlikely]]
-                        continue;
-                    
-                    // Direct framebuffer access and color construction
-                    src = Color(framebuffer[offset]);
-                    invAlpha = 0xF - currentAlpha;
-                    
-                    // Direct member assignment instead of constructor
-                    end.r = blendColor(src.r, red[i], currentAlpha);
-                    end.g = blendColor(src.g, green[i], currentAlpha);
-                    end.b = blendColor(src.b, blue[i], currentAlpha);
-                    end.a = static_cast<u8>(currentAlpha + (src.a * invAlpha >> 4));
-                    
-                    this->setPixel(currentX, baseY, end, offset);
+                s32 groupEnd;
+                while (x0 < x1) {
+                    groupEnd = std::min((x0 | 7) + 1, x1);
+                    fn(row + getColumnOffset(x0), x0, groupEnd - x0);
+                    x0 = groupEnd;
                 }
             }
+            
+            /**
+             * @brief Destination blends a solid color over the span [x0, x1) of row y
+             *
+             * @param clip Drawable area from getClipRect()
+             * @param x0 First x
+             * @param x1 One past the last x
+             * @param y Row
+             * @param color Color
+             */
+            inline void blendSpan(const ClipRect& clip, const s32 x0, const s32 x1, const s32 y, const Color& color) {
+                this->forEachRowRun(clip, x0, x1, y, [&color](u16* dst, s32, s32 runLength) {
+                    blend::dstUniform(dst, runLength, color);
+                });
+            }
+            
+            /**
+             * @brief Stores a solid color into the span [x0, x1) of row y without blending
+             *
+             * @param clip Drawable area from getClipRect()
+             * @param x0 First x
+             * @param x1 One past the last x
+             * @param y Row
+             * @param color Color
+             */
+            inline void fillSpan(const ClipRect& clip, const s32 x0, const s32 x1, const s32 y, const Color& color) {
+                const u16 value = color.rgba;
+                this->forEachRowRun(clip, x0, x1, y, [value](u16* dst, s32, s32 runLength) {
+                    std::fill_n(dst, runLength, value);
+                });
+            }
 
 
             /**
@@ -1454,6 +3905,12 @@ namespace tsl {
              * @param color Color
              */
             inline void drawRect(const s32 x, const s32 y, const s32 w, const s32 h, const Color& color) {
+                if (this->m_recording) [[unlikely]] {
+                    this->record(y, y + h, DisplayList::hash("drawRect", x, y, w, h, color),
+                        [=](Renderer& renderer) { renderer.drawRect(x, y, w, h, color); });
+                    return;
+                }
+                
                 // Early exit for invalid dimensions
                 //if (w <= 0 || h <= 0) return;
                 
@@ -1468,10 +3925,9 @@ namespace tsl {
                 
 
                 // Draw row by row for better cache locality
+                const ClipRect clip = this->getClipRect();
                 for (s32 yi = y_start; yi < y_end; ++yi) {
-                    for (s32 xi = x_start; xi < x_end; ++xi) {
-                        this->setPixelBlendDst(xi, yi, color);
-                    }
+                    this->blendSpan(clip, x_start, x_end, yi, color);
                 }
             }
 
@@ -1485,6 +3941,12 @@ namespace tsl {
              * @param color Color
              */
             inline void drawEmptyRect(s32 x, s32 y, s32 w, s32 h, Color color) {
+                if (this->m_recording) [[unlikely]] {
+                    this->record(y, y + h, DisplayList::hash("drawEmptyRect", x, y, w, h, color),
+                        [=](Renderer& renderer) { renderer.drawEmptyRect(x, y, w, h, color); });
+                    return;
+                }
+                
                 // Only precompute values that are actually reused
                 const s32 x_end = x + w - 1;
                 const s32 y_end = y + h - 1;
@@ -1503,18 +3965,16 @@ namespace tsl {
                 const s32 line_x_start = x < 0 ? 0 : x;
                 const s32 line_x_end = x_end >= cfg::FramebufferWidth ? cfg::FramebufferWidth - 1 : x_end;
                 
+                const ClipRect clip = this->getClipRect();
+                
                 // Draw top horizontal line
                 if (y >= 0 && y < cfg::FramebufferHeight) {
-                    for (s32 xi = line_x_start; xi <= line_x_end; ++xi) {
-                        this->setPixelBlendDst(xi, y, color);
-                    }
+                    this->blendSpan(clip, line_x_start, line_x_end + 1, y, color);
                 }
                 
                 // Draw bottom horizontal line (only if different from top)
                 if (h > 1 && y_end >= 0 && y_end < cfg::FramebufferHeight) {
-                    for (s32 xi = line_x_start; xi <= line_x_end; ++xi) {
-                        this->setPixelBlendDst(xi, y_end, color);
-                    }
+                    this->blendSpan(clip, line_x_start, line_x_end + 1, y_end, color);
                 }
                 
                 // Draw vertical lines only if there's space between horizontal lines
@@ -1552,6 +4012,12 @@ namespace tsl {
              * @param color Color
              */
             inline void drawLine(s32 x0, s32 y0, s32 x1, s32 y1, Color color) {
+                if (this->m_recording) [[unlikely]] {
+                    this->record(std::min(y0, y1), std::max(y0, y1) + 1, DisplayList::hash("drawLine", x0, y0, x1, y1, color),
+                        [=](Renderer& renderer) { renderer.drawLine(x0, y0, x1, y1, color); });
+                    return;
+                }
+                
                 // Early exit for single point
                 if (x0 == x1 && y0 == y1) {
                     if (x0 >= 0 && y0 >= 0 && x0 < cfg::FramebufferWidth && y0 < cfg::FramebufferHeight) {
@@ -1609,6 +4075,14 @@ namespace tsl {
              * @param color Color
              */
             inline void drawDashedLine(s32 x0, s32 y0, s32 x1, s32 y1, s32 line_width, Color color) {
+                if (this->m_recording) [[unlikely]] {
+                    this->record(std::min(y0, y1) - line_width, std::max(y0, y1) + line_width + 1,
+                                 DisplayList::hash("drawDashedLine", x0, y0, x1, y1, line_width, color), [=](Renderer& renderer) {
+                        renderer.drawDashedLine(x0, y0, x1, y1, line_width, color);
+                    });
+                    return;
+                }
+                
                 // Source of formula: https://www.cc.gatech.edu/grads/m/Aaron.E.McClennen/Bresenham/code.html
 
                 const s32 x_min = std::min(x0, x1);
@@ -1657,23 +4131,29 @@ namespace tsl {
             }
             
             inline void drawCircle(const s32 centerX, const s32 centerY, const u16 radius, const bool filled, const Color& color) {
+                if (this->m_recording) [[unlikely]] {
+                    this->record(centerY - radius, centerY + radius + 1,
+                                 DisplayList::hash("drawCircle", centerX, centerY, radius, filled, color), [=](Renderer& renderer) {
+                        renderer.drawCircle(centerX, centerY, radius, filled, color);
+                    });
+                    return;
+                }
+                
                 s32 x = radius;
                 s32 y = 0;
                 s32 radiusError = 0;
                 s32 xChange = 1 - (radius << 1);
                 s32 yChange = 0;
                 
+                const ClipRect clip = this->getClipRect();
+                
                 while (x >= y) {
                     if (filled) {
-                        for (s32 i = centerX - x; i <= centerX + x; i++) {
-                            this->setPixelBlendDst(i, centerY + y, color);
-                            this->setPixelBlendDst(i, centerY - y, color);
-                        }
+                        this->blendSpan(clip, centerX - x, centerX + x + 1, centerY + y, color);
+                        this->blendSpan(clip, centerX - x, centerX + x + 1, centerY - y, color);
                         
-                        for (s32 i = centerX - y; i <= centerX + y; i++) {
-                            this->setPixelBlendDst(i, centerY + x, color);
-                            this->setPixelBlendDst(i, centerY - x, color);
-                        }
+                        this->blendSpan(clip, centerX - y, centerX + y + 1, centerY + x, color);
+                        this->blendSpan(clip, centerX - y, centerX + y + 1, centerY - x, color);
                     } else {
                         this->setPixelBlendDst(centerX + x, centerY + y, color);
                         this->setPixelBlendDst(centerX + y, centerY + x, color);
@@ -1698,6 +4178,14 @@ namespace tsl {
             }
             
             inline void drawBorderedRoundedRect(const s32 x, const s32 y, const s32 width, const s32 height, const s32 thickness, const s32 radius, const Color& highlightColor) {
+                if (this->m_recording) [[unlikely]] {
+                    this->record(y - thickness - radius, y + height + thickness + radius + 2,
+                                 DisplayList::hash("drawBorderedRoundedRect", x, y, width, height, thickness, radius, highlightColor), [=](Renderer& renderer) {
+                        renderer.drawBorderedRoundedRect(x, y, width, height, thickness, radius, highlightColor);
+                    });
+                    return;
+                }
+                
                 const s32 startX = x + 4;
                 const s32 startY = y;
                 const s32 adjustedWidth = width - 12;
@@ -1722,39 +4210,25 @@ namespace tsl {
                 s32 xChange = 1 - (radius << 1);
                 s32 yChange = 0;
                 
+                const ClipRect clip = this->getClipRect();
+                
                 while (cx >= cy) {
                     // Draw horizontal spans for all 4 corners simultaneously
                     // Upper-left corner (quadrant 2) - two horizontal lines
-                    for (s32 i = leftCornerX - cx; i <= leftCornerX; i++) {
-                        this->setPixelBlendDst(i, topCornerY - cy, highlightColor);
-                    }
-                    for (s32 i = leftCornerX - cy; i <= leftCornerX; i++) {
-                        this->setPixelBlendDst(i, topCornerY - cx, highlightColor);
-                    }
+                    this->blendSpan(clip, leftCornerX - cx, leftCornerX + 1, topCornerY - cy, highlightColor);
+                    this->blendSpan(clip, leftCornerX - cy, leftCornerX + 1, topCornerY - cx, highlightColor);
                     
                     // Lower-left corner (quadrant 3) - two horizontal lines
-                    for (s32 i = leftCornerX - cx; i <= leftCornerX; i++) {
-                        this->setPixelBlendDst(i, bottomCornerY + cy, highlightColor);
-                    }
-                    for (s32 i = leftCornerX - cy; i <= leftCornerX; i++) {
-                        this->setPixelBlendDst(i, bottomCornerY + cx, highlightColor);
-                    }
+                    this->blendSpan(clip, leftCornerX - cx, leftCornerX + 1, bottomCornerY + cy, highlightColor);
+                    this->blendSpan(clip, leftCornerX - cy, leftCornerX + 1, bottomCornerY + cx, highlightColor);
                     
                     // Upper-right corner (quadrant 1) - two horizontal lines
-                    for (s32 i = rightCornerX; i <= rightCornerX + cx; i++) {
-                        this->setPixelBlendDst(i, topCornerY - cy, highlightColor);
-                    }
-                    for (s32 i = rightCornerX; i <= rightCornerX + cy; i++) {
-                        this->setPixelBlendDst(i, topCornerY - cx, highlightColor);
-                    }
+                    this->blendSpan(clip, rightCornerX, rightCornerX + cx + 1, topCornerY - cy, highlightColor);
+                    this->blendSpan(clip, rightCornerX, rightCornerX + cy + 1, topCornerY - cx, highlightColor);
                     
                     // Lower-right corner (quadrant 4) - two horizontal lines
-                    for (s32 i = rightCornerX; i <= rightCornerX + cx; i++) {
-                        this->setPixelBlendDst(i, bottomCornerY + cy, highlightColor);
-                    }
-                    for (s32 i = rightCornerX; i <= rightCornerX + cy; i++) {
-                        this->setPixelBlendDst(i, bottomCornerY + cx, highlightColor);
-                    }
+                    this->blendSpan(clip, rightCornerX, rightCornerX + cx + 1, bottomCornerY + cy, highlightColor);
+                    this->blendSpan(clip, rightCornerX, rightCornerX + cy + 1, bottomCornerY + cx, highlightColor);
                     
                     // Bresenham circle algorithm step
                     cy++;
@@ -1770,119 +4244,138 @@ namespace tsl {
             }
 
 
-            // Pre-compute all horizontal spans for the entire shape
-            struct HorizontalSpan {
-                s32 start_x, end_x;
-            };
-
-            // Define processChunk as a static member function
-            static void processRoundedRectChunk(Renderer* self, const s32 x, const s32 y, const s32 x_end, const s32 y_end, const s32 r2, const s32 radius, const Color& color, const s32 startRow, const s32 endRow) {
-                // All constant calculations moved outside loops
-                const s32 x_left = x + radius;
-                const s32 x_right = x_end - radius;
-                const s32 y_top = y + radius;
-                const s32 y_bottom = y_end - radius;
-                const s32 total_height = y_end - y;
-                
-                // Use stack allocation for small arrays to avoid heap allocation
-                alignas(64) u8 redArray[512], greenArray[512], blueArray[512], alphaArray[512];
-                const u8 red = color.r;
-                const u8 green = color.g;
-                const u8 blue = color.b;
-                const u8 alpha = color.a;
-                
-                // SIMD-optimized color array initialization (if available)
-                #ifdef __AVX2__
-                const __m256i color_vec = _mm256_set1_epi32((alpha << 24) | (blue << 16) | (green << 8) | red);
-                for (s32 i = 0; i < 512; i += 8) {
-                    _mm256_store_si256((__m256i*)(redArray + i), _mm256_and_si256(color_vec, _mm256_set1_epi32(0xFF)));
-                    _mm256_store_si256((__m256i*)(greenArray + i), _mm256_and_si256(_mm256_srli_epi32(color_vec, 8), _mm256_set1_epi32(0xFF)));
-                    _mm256_store_si256((__m256i*)(blueArray + i), _mm256_and_si256(_mm256_srli_epi32(color_vec, 16), _mm256_set1_epi32(0xFF)));
-                    _mm256_store_si256((__m256i*)(alphaArray + i), _mm256_and_si256(_mm256_srli_epi32(color_vec, 24), _mm256_set1_epi32(0xFF)));
-                }
-                #else
-                // Fallback: unroll the loop for better performance
-                for (s32 i = 0; i < 512; i += 8) {
-                    redArray[i] = redArray[i+1] = redArray[i+2] = redArray[i+3] = 
-                    redArray[i+4] = redArray[i+5] = redArray[i+6] = redArray[i+7] = red;
-                    greenArray[i] = greenArray[i+1] = greenArray[i+2] = greenArray[i+3] = 
-                    greenArray[i+4] = greenArray[i+5] = greenArray[i+6] = greenArray[i+7] = green;
-                    blueArray[i] = blueArray[i+1] = blueArray[i+2] = blueArray[i+3] = 
-                    blueArray[i+4] = blueArray[i+5] = blueArray[i+6] = blueArray[i+7] = blue;
-                    alphaArray[i] = alphaArray[i+1] = alphaArray[i+2] = alphaArray[i+3] = 
-                    alphaArray[i+4] = alphaArray[i+5] = alphaArray[i+6] = alphaArray[i+7] = alpha;
-                }
-                #endif
-                
-                // Only compute spans for rows we actually need
-                const s32 first_row_idx = std::max(0, startRow - y);
-                const s32 last_row_idx = std::min(total_height - 1, endRow - y - 1);
-                
-                // Use stack allocation for small span arrays
-                HorizontalSpan spans[512]; // Assuming reasonable max height
-                const bool use_heap = (last_row_idx - first_row_idx + 1) > 512;
-                std::vector<HorizontalSpan> heap_spans;
-                
-                HorizontalSpan* span_ptr;
-                if (use_heap) {
-                    heap_spans.resize(last_row_idx - first_row_idx + 1);
-                    span_ptr = heap_spans.data();
-                } else {
-                    span_ptr = spans;
+            /**
+             * @brief Returns the span mask for a rounded rectangle size, building and caching it on first use
+             * @note Only the few sizes drawn every frame (list highlights, footer buttons) are kept, most recent
+             *       first. Masks are shared so recorded draws keep theirs alive while the cache moves on.
+             *
+             * @param w Width
+             * @param h Height
+             * @param radius Corner radius
+             */
+            std::shared_ptr<const RoundedRectMask> getRoundedRectMask(const s32 w, const s32 h, const s32 radius) {
+                auto& masks = this->m_roundedRectMasks;
+                for (size_t i = 0; i < masks.size(); ++i) {
+                    const auto& mask = masks[i];
+                    if (mask->width == w && mask->height == h && mask->radius == radius) {
+                        if (i > 0)
+                            std::rotate(masks.begin(), masks.begin() + i, masks.begin() + i + 1);
+                        return masks.front();
+                    }
+                }
+                
+                auto mask = std::make_shared<RoundedRectMask>();
+                mask->width = w;
+                mask->height = h;
+                mask->radius = radius;
+                mask->rows.resize(h);
+                
+                const s32 r2 = radius * radius;
+                for (s32 row = 0; row < h; ++row) {
+                    RoundedRectMask::Row& span = mask->rows[row];
+                    span = { 0, w, 0, 0 };
+                    
+                    // Middle rows span the full width; corner rows are measured from the circle centers
+                    const bool isTopSection = row < radius;
+                    if (!isTopSection && row < h - radius)
+                        continue;
+                    
+                    const s32 dy = isTopSection ? radius - row : row - (h - radius);
+                    const s32 dy2 = dy * dy;
+                    if (dy2 > r2) {
+                        span.start = span.end = 0;
+                        continue;
+                    }
+                    
+                    const float exactDx = std::sqrt(static_cast<float>(r2 - dy2));
+                    const s32 maxDx = static_cast<s32>(std::sqrt(r2 - dy2));
+                    span.start = std::max(radius - maxDx, 0);
+                    span.end = std::min(w - radius + maxDx, w);
+                    
+                    // The pixel just outside each end is partly covered by the true circle
+                    const u8 coverage = static_cast<u8>(std::clamp(static_cast<s32>((exactDx - maxDx) * 15.0f + 0.5f), 0, 15));
+                    if (span.start > 0)
+                        span.leftCoverage = coverage;
+                    if (span.end < w)
+                        span.rightCoverage = coverage;
                 }
                 
-                // Pre-compute spans only for needed rows
-                s32 span_idx = 0;
-                for (s32 row_idx = first_row_idx; row_idx <= last_row_idx; ++row_idx) {
-                    const s32 y1 = y + row_idx;
+                masks.insert(masks.begin(), std::move(mask));
+                if (masks.size() > RoundedRectMaskCacheSize)
+                    masks.pop_back();
+                return masks.front();
+            }
+            
+            /**
+             * @brief Blends the rows [firstRow, lastRow) of a rounded rectangle mask placed at (x, y)
+             *
+             * @param clip Drawable area from getClipRect()
+             * @param mask Span mask
+             * @param x X pos
+             * @param y Y pos
+             * @param color Color
+             * @param antiAliased Also blend the partially covered pixels around every span
+             * @param firstRow First screen row
+             * @param lastRow One past the last screen row
+             */
+            inline void fillRoundedRectMask(const ClipRect& clip, const RoundedRectMask& mask, const s32 x, const s32 y, const Color& color,
+                                            const bool antiAliased, const s32 firstRow, const s32 lastRow) {
+                for (s32 py = firstRow; py < lastRow; ++py) {
+                    const RoundedRectMask::Row& span = mask.rows[py - y];
+                    if (span.start < span.end)
+                        this->blendSpan(clip, x + span.start, x + span.end, py, color);
                     
-                    if (y1 >= y_top && y1 < y_bottom) {
-                        // Middle section - direct assignment
-                        span_ptr[span_idx].start_x = x;
-                        span_ptr[span_idx].end_x = x_end;
-                    } else {
-                        // Corner section - optimize with lookup table for small radii
-                        const bool isTopSection = (y1 < y_top);
-                        const s32 corner_y = isTopSection ? y_top : y_bottom;
-                        const s32 dy = abs(y1 - corner_y);
-                        const s32 dy2 = dy * dy;
-                        
-                        if (dy2 > r2) {
-                            span_ptr[span_idx].start_x = 0;
-                            span_ptr[span_idx].end_x = 0; // Empty span
-                        } else {
-                            // Use fast integer square root for better performance
-                            const s32 max_dx = static_cast<s32>(std::sqrt(r2 - dy2));
-                            span_ptr[span_idx].start_x = std::max(x_left - max_dx, x);
-                            span_ptr[span_idx].end_x = std::min(x_right + max_dx, x_end);
+                    if (antiAliased) {
+                        if (span.leftCoverage) {
+                            const u8 alpha = static_cast<u8>((color.a * span.leftCoverage + 7) / 15);
+                            if (alpha) this->blendSpan(clip, x + span.start - 1, x + span.start, py, Color(color.r, color.g, color.b, alpha));
+                        }
+                        if (span.rightCoverage) {
+                            const u8 alpha = static_cast<u8>((color.a * span.rightCoverage + 7) / 15);
+                            if (alpha) this->blendSpan(clip, x + span.end, x + span.end + 1, py, Color(color.r, color.g, color.b, alpha));
                         }
                     }
-                    ++span_idx;
+                }
+            }
+            
+            /**
+             * @brief Shared body of the rounded rectangle draws
+             */
+            inline void drawRoundedRectMasked(const char* name, const s32 x, const s32 y, const s32 w, const s32 h, const s32 radius,
+                                              const Color& color, const bool antiAliased, const bool multiThreaded) {
+                // A fully transparent color leaves every pixel untouched
+                if (w <= 0 || h <= 0 || color.a == 0) return;
+                
+                std::shared_ptr<const RoundedRectMask> mask = this->getRoundedRectMask(w, h, radius);
+                
+                if (this->m_recording) [[unlikely]] {
+                    this->record(y, y + h, DisplayList::hash(name, x, y, w, h, radius, color),
+                        [=](Renderer& renderer) {
+                            const ClipRect clip = renderer.getClipRect();
+                            renderer.fillRoundedRectMask(clip, *mask, x, y, color, antiAliased,
+                                                         std::max(y, clip.y0), std::min(y + h, clip.y1));
+                        });
+                    return;
                 }
                 
-                // Render using pre-computed spans with larger batch sizes
-                span_idx = 0;
-                for (s32 y_current = startRow; y_current < endRow; ++y_current) {
-                    const s32 row_idx = y_current - y;
-                    if (row_idx < first_row_idx || row_idx > last_row_idx) continue;
-                    
-                    const HorizontalSpan* span = &span_ptr[span_idx++];
-                    if (span->start_x >= span->end_x) continue;
-                    
-                    // Draw with larger batch size for better cache utilization
-                    s32 x_pos = span->start_x;
-                    while (x_pos < span->end_x) {
-                        const s32 remaining = span->end_x - x_pos;
-                        const s32 batch_size = std::min(remaining, 512);
-                        
-                        self->setPixelBlendDstBatch(x_pos, y_current, redArray, greenArray, blueArray, alphaArray, batch_size);
-                        x_pos += batch_size;
-                    }
+                // Only rows inside the clip are worth dividing up
+                const ClipRect clip = this->getClipRect();
+                const s32 firstRow = std::max(y, clip.y0);
+                const s32 lastRow = std::min(y + h, clip.y1);
+                if (firstRow >= lastRow) return;
+                
+                // For small rectangles, stay on the calling thread
+                if (!multiThreaded || w * h < 1000) {
+                    this->fillRoundedRectMask(clip, *mask, x, y, color, antiAliased, firstRow, lastRow);
+                    return;
                 }
+                
+                const s32 chunkSize = std::max((s32)1, (s32)(h / (this->m_workerPool.size() * 2)));
+                this->m_workerPool.parallelFor(firstRow, lastRow, chunkSize, [&](s32 startRow, s32 endRow) {
+                    this->fillRoundedRectMask(clip, *mask, x, y, color, antiAliased, startRow, endRow);
+                });
             }
 
-
-
             /**
              * @brief Draws a rounded rectangle of given sizes and corner radius
              *
@@ -1894,52 +4387,27 @@ namespace tsl {
              * @param color Color
              */
             inline void drawRoundedRectMultiThreaded(const s32 x, const s32 y, const s32 w, const s32 h, const s32 radius, const Color& color) {
-                if (w <= 0 || h <= 0) return;
-                
-                // For small rectangles, use single-threaded version
-                if (w * h < 1000) {
-                    drawRoundedRectSingleThreaded(x, y, w, h, radius, color);
-                    return;
-                }
-                
-                // Use the existing multi-threaded approach but with better chunk sizes
-                s32 x_end = x + w;
-                s32 y_end = y + h;
-                s32 r2 = radius * radius;
-                
-                // Dynamic chunk size based on rectangle size
-                s32 chunkSize = std::max((s32)1, (s32)(h / (ult::numThreads * 2)));
-                std::atomic<s32> currentRow(y);
-                
-                auto threadTask = [&]() {
-                    s32 startRow, endRow;
-                    while ((startRow = currentRow.fetch_add(chunkSize)) < y_end) {
-                        endRow = std::min(startRow + chunkSize, y_end);
-                        processRoundedRectChunk(this, x, y, x_end, y_end, r2, radius, color, startRow, endRow);
-                    }
-                };
-                
-                // Launch threads
-                std::vector<std::thread> threads;
-                threads.reserve(ult::numThreads);
-                
-                for (unsigned i = 0; i < ult::numThreads; ++i) {
-                    threads.emplace_back(threadTask);
-                }
-                
-                for (auto& t : threads) {
-                    t.join();
-                }
+                this->drawRoundedRectMasked("drawRoundedRectMultiThreaded", x, y, w, h, radius, color, false, true);
             }
 
 
             inline void drawRoundedRectSingleThreaded(const s32 x, const s32 y, const s32 w, const s32 h, const s32 radius, const Color& color) {
-                //const s32 x_end = x + w;
-                const s32 y_end = y + h;
-                //const s32 r2 = radius * radius;
-                
-                // Call the processRoundedRectChunk function directly for the entire rectangle
-                processRoundedRectChunk(this, x, y, x + w, y_end, radius * radius, radius, color, y, y_end);
+                this->drawRoundedRectMasked("drawRoundedRectSingleThreaded", x, y, w, h, radius, color, false, false);
+            }
+            
+            /**
+             * @brief Draws a rounded rectangle with anti-aliased corners
+             * @note Same spans as drawRoundedRect, plus the partially covered pixel at either end of each corner row.
+             *
+             * @param x X pos
+             * @param y Y pos
+             * @param w Width
+             * @param h Height
+             * @param radius Corner radius
+             * @param color Color
+             */
+            inline void drawRoundedRectAntiAliased(const s32 x, const s32 y, const s32 w, const s32 h, const s32 radius, const Color& color) {
+                this->drawRoundedRectMasked("drawRoundedRectAntiAliased", x, y, w, h, radius, color, true, ult::expandedMemory);
             }
 
             std::function<void(s32, s32, s32, s32, s32, Color)> drawRoundedRect;
@@ -1957,6 +4425,12 @@ namespace tsl {
             
                         
             inline void drawUniformRoundedRect(const s32 x, const s32 y, const s32 w, const s32 h, const Color& color) {
+                if (this->m_recording) [[unlikely]] {
+                    this->record(y, y + h, DisplayList::hash("drawUniformRoundedRect", x, y, w, h, color),
+                        [=](Renderer& renderer) { renderer.drawUniformRoundedRect(x, y, w, h, color); });
+                    return;
+                }
+                
                 // Early exit for degenerate cases
                 //if (w <= 0 || h <= 0) return;
                 
@@ -1970,49 +4444,30 @@ namespace tsl {
                 const s32 center_y = y + radius;
                 
                 // Pre-declare all loop variables outside loops
-                s32 y1, x1, x_offset;
-                s32 dy, dy_sq, dist_sq;
-                s32 max_x_offset_for_row;
-                s32 left_x, right_x;
+                s32 y1, x_offset;
+                s32 dy, dy_sq;
+                
+                const ClipRect clip = this->getClipRect();
                 
-                // Draw the central rectangle (unchanged - this is already optimal)
+                // Draw the central rectangle
                 for (y1 = y; y1 < y + h; ++y1) {
-                    for (x1 = x_start; x1 < x_end; ++x1) {
-                        this->setPixelBlendDst(x1, y1, color);
-                    }
+                    this->blendSpan(clip, x_start, x_end, y1, color);
                 }
                 
-                // Optimized semicircle drawing with precomputed values
+                // Semicircle caps, one contiguous span per side and row
                 for (y1 = y; y1 < y + h; ++y1) {
                     dy = y1 - center_y;
                     dy_sq = dy * dy;
                     
-                    // Calculate the exact maximum x_offset for this row to avoid unnecessary iterations
-                    // max_x_offset^2 + dy^2 = radius^2, so max_x_offset = sqrt(radius^2 - dy^2)
-                    if (dy_sq >= radius_sq) continue; // Skip rows completely outside the circle
-                    
-                    // Use integer square root approximation or simple bound
-                    max_x_offset_for_row = radius; // Conservative bound, could be optimized further
+                    // Skip rows completely outside the circle
+                    if (dy_sq >= radius_sq) continue;
                     
-                    // Precompute the x coordinates
-                    left_x = x + radius;
-                    right_x = x + w - radius;
+                    // Widest x_offset (exclusive) with x_offset^2 + dy^2 <= radius^2
+                    for (x_offset = 0; x_offset < radius && x_offset * x_offset + dy_sq <= radius_sq; ++x_offset) {}
                     
-                    for (x_offset = 0; x_offset < max_x_offset_for_row; ++x_offset) {
-                        dist_sq = x_offset * x_offset + dy_sq;
-                        
-                        if (dist_sq <= radius_sq) {
-                            // Left semicircle
-                            this->setPixelBlendDst(left_x - x_offset, y1, color);
-                            // Right semicircle (only if x_offset > 0 to avoid double-drawing center)
-                            if (x_offset > 0) {
-                                this->setPixelBlendDst(right_x + x_offset, y1, color);
-                            }
-                        } else {
-                            // Once we're outside the circle, no need to check further x values
-                            break;
-                        }
-                    }
+                    // Left cap ends on x_start, right cap starts at x_end + 1 (same pixels as the per-pixel version)
+                    this->blendSpan(clip, x_start - x_offset + 1, x_start + 1, y1, color);
+                    this->blendSpan(clip, x_end + 1, x_end + x_offset, y1, color);
                 }
             }
                         
@@ -2034,161 +4489,336 @@ namespace tsl {
                 }
             }
 
-            // Fixed compilation errors - simplified SIMD version
-            const uint8x16_t lut = {0, 17, 34, 51, 68, 85, 102, 119, 136, 153, 170, 187, 204, 221, 238, 255};
-            const uint8x16_t mask_low = vdupq_n_u8(0x0F);
-            // Pre-computed lookup table for 4-bit to 8-bit conversion
-            const u8 expand4to8[16] = {
-                0, 17, 34, 51, 68, 85, 102, 119, 136, 153, 170, 187, 204, 221, 238, 255
-            };
-            
             inline void processBMPChunk(const s32 x, const s32 y, const s32 screenW, const u8 *preprocessedData, 
                                        const s32 startRow, const s32 endRow) {
                 const s32 bytesPerRow = screenW * 2;
-                const s32 endX16 = screenW & ~15;
-                
-                // Pre-declare all variables outside loops to avoid repeated allocations
                 const u8 *rowPtr;
-                s32 baseY;
-                s32 x1;
-                const u8* ptr;
-                uint8x16x2_t packed;
-                uint8x16_t high1, low1, high2, low2;
-                uint8x16_t red, green, blue, alpha;
-                alignas(16) u8 red_vals[16], green_vals[16], blue_vals[16], alpha_vals[16];
-                s32 baseX;
-                s32 pixelX;
-                u32 offset;
-                Color color = {0}, src = {0}, end = {0};
-                const u16* framebuffer;
-                u8 p1, p2;
                 
                 for (s32 y1 = startRow; y1 < endRow; ++y1) {
                     rowPtr = preprocessedData + (y1 * bytesPerRow);
-                    baseY = y + y1;
-                    
-                    x1 = 0;
                     
-                    // SIMD processing for 16 pixels at once
-                    for (; x1 < endX16; x1 += 16) {
-                        ptr = rowPtr + (x1 << 1);
-                        packed = vld2q_u8(ptr);
-                        
-                        // Expand 4-bit to 8-bit values
-                        high1 = vshrq_n_u8(packed.val[0], 4);
-                        low1  = vandq_u8(packed.val[0], mask_low);
-                        high2 = vshrq_n_u8(packed.val[1], 4);
-                        low2  = vandq_u8(packed.val[1], mask_low);
-                        
-                        red   = vqtbl1q_u8(lut, high1);
-                        green = vqtbl1q_u8(lut, low1);
-                        blue  = vqtbl1q_u8(lut, high2);
-                        alpha = vqtbl1q_u8(lut, low2);
-                        
-                        // Store to arrays and process individually
-                        vst1q_u8(red_vals, red);
-                        vst1q_u8(green_vals, green); 
-                        vst1q_u8(blue_vals, blue);
-                        vst1q_u8(alpha_vals, alpha);
-                        
-                        baseX = x + x1;
-                        
-                        // Process 16 pixels with minimal function call overhead
-                        for (int i = 0; i < 16; ++i) {
-                            // Skip transparent pixels
-                            if (alpha_vals[i] == 0) continue;
-                            
-                            pixelX = baseX + i;
-                            offset = this->getPixelOffset(pixelX, baseY);
-                            
-                            if (offset != UINT32_MAX) {
-                                color = {red_vals[i], green_vals[i], blue_vals[i], alpha_vals[i]};
-                                
-                                framebuffer = static_cast<const u16*>(this->getCurrentFramebuffer());
-                                src = Color(framebuffer[offset]);
-                                
-                                end = {
-                                    blendColor(src.r, color.r, color.a),
-                                    blendColor(src.g, color.g, color.a), 
-                                    blendColor(src.b, color.b, color.a),
-                                    src.a
-                                };
+                    // Blend contiguous 8 pixel groups straight from the packed source
+                    this->forEachRowRun(x, x + screenW, y + y1, [rowPtr, x](u16* dst, s32 pixelX, s32 runLength) {
+                        blend::srcBitmap(dst, runLength, rowPtr + ((pixelX - x) << 1));
+                    });
+                }
+            }
+            
+
+
+
+            /**
+             * @brief Draws a scaled RGBA8888 bitmap from memory
+             *
+             * @param x X start position
+             * @param y Y start position
+             * @param w Bitmap width (original width of the bitmap)
+             * @param h Bitmap height (original height of the bitmap)
+             * @param bmp Pointer to bitmap data
+             * @param screenW Target screen width
+             * @param screenH Target screen height
+             * @param version Changes whenever the pixels behind preprocessedData do, 0 if the caller doesn't track them
+             * @note Partial redraw can only skip the bitmap's bands while the version stays the same, an unversioned
+             *       bitmap is redrawn every frame.
+             */
+
+            inline void drawBitmapRGBA4444(const s32 x, const s32 y, const s32 screenW, const s32 screenH, const u8 *preprocessedData,
+                                           const u64 version = 0) {
+                if (this->m_recording) [[unlikely]] {
+                    // The source must stay alive until the frame ends (the wallpaper is pinned by ult::inPlot)
+                    const u64 hash = DisplayList::hash("drawBitmapRGBA4444", x, y, screenW, screenH, static_cast<const void*>(preprocessedData),
+                                                       version, version != 0 ? 0 : this->m_frameNumber);
+                    this->record(y, y + screenH, hash, [=](Renderer& renderer) {
+                        renderer.drawBitmapRGBA4444(x, y, screenW, screenH, preprocessedData);
+                    });
+                    return;
+                }
+                
+                const ClipRect clip = this->getClipRect();
+                const s32 firstRow = std::max(0, clip.y0 - y);
+                const s32 lastRow = std::min(screenH, clip.y1 - y);
+                
+                // One chunk of rows per pool thread
+                const s32 threadCount = static_cast<s32>(this->m_workerPool.size());
+                const s32 chunkSize = (lastRow - firstRow + threadCount - 1) / threadCount;
+                
+                this->m_workerPool.parallelFor(firstRow, lastRow, chunkSize, [&](s32 startRow, s32 endRow) {
+                    this->processBMPChunk(x, y, screenW, preprocessedData, startRow, endRow);
+                });
+            }
+
+
+            /**
+             * @brief Content version of ult::wallpaperData for drawBitmapRGBA4444, follows its load generation
+             */
+            static inline u64 getWallpaperVersion() {
+                return (static_cast<u64>(1) << 32) | ult::wallpaperGeneration.load(std::memory_order_acquire);
+            }
+            
+            inline void drawWallpaper() {
+                TSL_PROFILE_PHASE(Background);
+                if (ult::expandedMemory && !ult::refreshWallpaper.load(std::memory_order_acquire)) {
+                    //ult::inPlot = true;
+                    ult::inPlot.store(true, std::memory_order_release);
+                    //std::lock_guard<std::mutex> lock(wallpaperMutex);
+                    if (!ult::wallpaperData.empty()) {
+                        // Draw the bitmap at position (0, 0) on the screen
+                        //static bool ult::correctFrameSize = (cfg::FramebufferWidth == 448 && cfg::FramebufferHeight == 720);
+                        if (!ult::refreshWallpaper.load(std::memory_order_acquire) && ult::correctFrameSize) { // hard coded width and height for consistency
+                            drawBitmapRGBA4444(0, 0, cfg::FramebufferWidth, cfg::FramebufferHeight, ult::wallpaperData.data(),
+                                               getWallpaperVersion());
                             
-                                this->setPixel(pixelX, baseY, end, offset);
-                            }
-                        }
+                            // A recorded draw reads the wallpaper when the display list is flushed
+                            if (this->m_recording)
+                                this->m_releasePlotOnFlush = true;
+                            else
+                                ult::inPlot.store(false, std::memory_order_release);
+                        } else
+                            ult::inPlot.store(false, std::memory_order_release);
+                    } else {
+                        ult::inPlot.store(false, std::memory_order_release);
                     }
+                    //ult::inPlot = false;
+                }
+            }
+
+
+            /**
+             * @brief Static rectangle baked into the background layer
+             */
+            struct StaticRect {
+                s32 x, y, w, h;
+                Color color;
+            };
+            
+            /**
+             * @brief Draws the background fill, wallpaper and static chrome from a precomposited layer
+             * @note Equivalent to fillScreen(fillColor), drawWallpaper() and a drawRect() per chrome entry. The
+             *       composite is kept in swizzled framebuffer order and rebuilt only when the fill color (theme or
+             *       opacity), the chrome or the wallpaper changes; every other frame starts with a bulk copy.
+             *       Without expanded memory there is no wallpaper and the layer isn't worth its memory, so the
+             *       pieces are drawn directly, as they are while a scissor is active.
+             *
+             * @param fillColor Background color
+             * @param chrome Rectangles drawn over the wallpaper (separators, borders)
+             */
+            inline void drawStaticBackground(const Color& fillColor, std::initializer_list<StaticRect> chrome = {}) {
+                TSL_PROFILE_PHASE(Background);
+                
+                if (!ult::expandedMemory || !this->m_scissoringStack.empty()) {
+                    this->fillScreen(fillColor);
+                    this->drawWallpaper();
+                    for (const auto& rect : chrome)
+                        this->drawRect(rect.x, rect.y, rect.w, rect.h, rect.color);
                     
-                    // Handle remaining pixels (less than 16)
-                    for (; x1 < screenW; ++x1) {
-                        p1 = rowPtr[x1 << 1];
-                        p2 = rowPtr[(x1 << 1) + 1];
-                        
-                        setPixelBlendSrc(x + x1, baseY, {
-                            expand4to8[p1 >> 4], expand4to8[p1 & 0x0F],
-                            expand4to8[p2 >> 4], expand4to8[p2 & 0x0F]
+                    // Without expanded memory there is no wallpaper, so the background can be repainted from its pieces
+                    if (!ult::expandedMemory && this->m_scissoringStack.empty()) {
+                        u64 key = DisplayList::hash("background", fillColor);
+                        for (const auto& rect : chrome)
+                            key = DisplayList::combine(key, DisplayList::hash("", rect.x, rect.y, rect.w, rect.h, rect.color));
+                        this->setFrameBackground(key, false);
+                        this->m_frameBackgroundColor = fillColor;
+                        this->m_frameBackgroundChrome.assign(chrome.begin(), chrome.end());
+                    }
+                    return;
+                }
+                
+                // Hold the wallpaper while it is sampled and possibly composited
+                ult::inPlot.store(true, std::memory_order_release);
+                
+                const bool withWallpaper = !ult::refreshWallpaper.load(std::memory_order_acquire) &&
+                                           !ult::wallpaperData.empty() && ult::correctFrameSize;
+                
+                // The wallpaper is keyed on its load generation, a reload rebuilds the layer even if few pixels changed
+                u64 key = DisplayList::hash("background", fillColor, cfg::FramebufferWidth, cfg::FramebufferHeight,
+                                            withWallpaper ? getWallpaperVersion() : 0);
+                for (const auto& rect : chrome)
+                    key = DisplayList::combine(key, DisplayList::hash("", rect.x, rect.y, rect.w, rect.h, rect.color));
+                
+                if (key != this->m_backgroundKey || this->m_backgroundLayer.size() != this->getTargetSize() / sizeof(u16)) {
+                    this->rebuildBackgroundLayer(fillColor, chrome, withWallpaper);
+                    this->m_backgroundKey = key;
+                }
+                
+                ult::inPlot.store(false, std::memory_order_release);
+                
+                if (!withWallpaper)
+                    this->setFrameBackground(key, true);
+                
+                if (this->m_recording) [[unlikely]] {
+                    // Like fillScreen, the layer covers the whole framebuffer regardless of the scissor
+                    const ClipRect screen = { 0, 0, cfg::FramebufferWidth, cfg::FramebufferHeight };
+                    this->m_displayList.record(0, cfg::FramebufferHeight, screen, DisplayList::hash("backgroundLayer", key),
+                        [](Renderer& renderer) { renderer.blitBackgroundLayer(); });
+                    return;
+                }
+                
+                this->blitBackgroundLayer();
+            }
+            
+            /**
+             * @brief Drops the cached background layer
+             */
+            inline void releaseBackgroundLayer() {
+                this->m_backgroundLayer.clear();
+                this->m_backgroundLayer.shrink_to_fit();
+                this->m_backgroundKey = 0;
+                this->m_frameBackgroundKey = 0;
+            }
+            
+            /**
+             * @brief Identifies the background and the global draw state (opacity, fonts) of the current frame
+             * @note Only set when drawStaticBackground painted a background without wallpaper this frame, which
+             *       looks the same at every position; 0 otherwise.
+             */
+            inline u64 getFrameBackgroundKey() const {
+                return this->m_frameBackgroundKey;
+            }
+            
+            /**
+             * @brief Number of frames ended so far
+             */
+            inline u32 getFrameNumber() const {
+                return this->m_frameNumber;
+            }
+            
+            /**
+             * @brief Repaints the background drawStaticBackground drew this frame inside a rectangle
+             *
+             * @param x X pos
+             * @param y Y pos
+             * @param w Width
+             * @param h Height
+             * @return false when the frame's background isn't known
+             */
+            bool restoreBackground(const s32 x, const s32 y, const s32 w, const s32 h) {
+                if (this->m_frameBackgroundKey == 0 || this->m_recording)
+                    return false;
+                
+                const ClipRect clip = {
+                    std::max(x, 0), std::max(y, 0),
+                    std::min<s32>(x + w, cfg::FramebufferWidth), std::min<s32>(y + h, cfg::FramebufferHeight)
+                };
+                if (clip.x0 >= clip.x1 || clip.y0 >= clip.y1)
+                    return true;
+                
+                if (this->m_frameBackgroundFromLayer) {
+                    u16* const framebuffer = static_cast<u16*>(this->getCurrentFramebuffer());
+                    const u16* const layer = this->m_backgroundLayer.data();
+                    for (s32 row = clip.y0; row < clip.y1; ++row) {
+                        this->forEachRowRun(clip, clip.x0, clip.x1, row, [framebuffer, layer](u16* dst, s32, s32 runLength) {
+                            std::memcpy(dst, layer + (dst - framebuffer), runLength * sizeof(u16));
                         });
                     }
+                    return true;
                 }
                 
-                ult::inPlotBarrier.arrive_and_wait();
+                for (s32 row = clip.y0; row < clip.y1; ++row)
+                    this->fillSpan(clip, clip.x0, clip.x1, row, this->m_frameBackgroundColor);
+                
+                this->enableScissoring(clip.x0, clip.y0, clip.x1 - clip.x0, clip.y1 - clip.y0);
+                for (const auto& rect : this->m_frameBackgroundChrome)
+                    this->drawRect(rect.x, rect.y, rect.w, rect.h, rect.color);
+                this->disableScissoring();
+                return true;
             }
             
-
-
-
             /**
-             * @brief Draws a scaled RGBA8888 bitmap from memory
+             * @brief Copies a rectangle of the previously presented frame into the current one, moved down by dy rows
+             * @note Rows whose source would lie outside the rectangle are left untouched. The copy works on the
+             *       largest swizzle tiles the move keeps intact. Only valid for immediate frames, a recorded frame
+             *       paints over the copy when it is flushed.
              *
-             * @param x X start position
-             * @param y Y start position
-             * @param w Bitmap width (original width of the bitmap)
-             * @param h Bitmap height (original height of the bitmap)
-             * @param bmp Pointer to bitmap data
-             * @param screenW Target screen width
-             * @param screenH Target screen height
+             * @param x X pos
+             * @param y Y pos
+             * @param w Width
+             * @param h Height
+             * @param dy Rows to move down, negative to move up
+             * @return false when there is no previous frame to copy from
              */
-
-            inline void drawBitmapRGBA4444(const s32 x, const s32 y, const s32 screenW, const s32 screenH, const u8 *preprocessedData) {
-                s32 startRow;
-
-                // Divide rows among ult::threads
-                //s32 chunkSize = (screenH + ult::numThreads - 1) / ult::numThreads;
-                for (unsigned i = 0; i < ult::numThreads; ++i) {
-                    startRow = i * ult::bmpChunkSize;
-                    //s32 endRow = std::min(startRow + ult::bmpChunkSize, screenH);
-                    
-                    // Bind the member function and create the thread
-                    ult::threads[i] = std::thread(std::bind(&tsl::gfx::Renderer::processBMPChunk, this, x, y, screenW, preprocessedData, startRow, std::min(startRow + ult::bmpChunkSize, screenH)));
-                }
-            
-                // Join all ult::threads
-                for (auto& t : ult::threads) {
-                    t.join();
+            bool scrollPreviousFrame(const s32 x, const s32 y, const s32 w, const s32 h, const s32 dy) {
+                if (this->m_recording || this->m_frameNumber == 0 || this->getFramebufferCount() < 2 ||
+                    this->m_lastPresentedSlot == this->getCurrentFramebufferSlot())
+                    return false;
+                
+                u16* const framebuffer = static_cast<u16*>(this->getCurrentFramebuffer());
+                const u16* const previous = static_cast<const u16*>(this->getFramebufferSlotData(this->m_lastPresentedSlot));
+                
+                const s32 x0 = std::max(x, 0);
+                const s32 x1 = std::min<s32>(x + w, cfg::FramebufferWidth);
+                const s32 y0 = std::max({ y, y + dy, 0 });
+                const s32 y1 = std::min({ y + h, y + h + dy, static_cast<s32>(cfg::FramebufferHeight) });
+                if (x0 >= x1 || y0 >= y1)
+                    return true;
+                
+                // The presented frame is swizzled, the linear back buffer takes each of its 8 pixel groups as is
+                if (this->m_linearTarget) {
+                    this->markWritten(x0, x1, y0, y1);
+                    s32 groupEnd;
+                    for (s32 row = y0; row < y1; ++row) {
+                        u16* const dst = framebuffer + this->getRowOffset(row);
+                        const u16* const src = previous + computeRowOffset(row - dy);
+                        for (s32 from = x0; from < x1; from = groupEnd) {
+                            groupEnd = std::min((from | 7) + 1, x1);
+                            if (groupEnd - from == 8)
+                                std::memcpy(dst + from, src + getColumnOffset(from), 8 * sizeof(u16));
+                            else
+                                std::memcpy(dst + from, src + getColumnOffset(from), (groupEnd - from) * sizeof(u16));
+                        }
+                    }
+                    return true;
                 }
-            }
-
-
-            inline void drawWallpaper() {
-                if (ult::expandedMemory && !ult::refreshWallpaper.load(std::memory_order_acquire)) {
-                    //ult::inPlot = true;
-                    ult::inPlot.store(true, std::memory_order_release);
-                    //std::lock_guard<std::mutex> lock(wallpaperMutex);
-                    if (!ult::wallpaperData.empty()) {
-                        // Draw the bitmap at position (0, 0) on the screen
-                        //static bool ult::correctFrameSize = (cfg::FramebufferWidth == 448 && cfg::FramebufferHeight == 720);
-                        if (!ult::refreshWallpaper.load(std::memory_order_acquire) && ult::correctFrameSize) { // hard coded width and height for consistency
-                            drawBitmapRGBA4444(0, 0, cfg::FramebufferWidth, cfg::FramebufferHeight, ult::wallpaperData.data());
-                        } else
-                            ult::inPlot.store(false, std::memory_order_release);
+                
+                // Only groups of 8 pixels are contiguous, full groups copy with a fixed size
+                const auto copySpan = [framebuffer, previous](const u32 dstRow, const u32 srcRow, s32 from, const s32 to) {
+                    s32 groupEnd;
+                    u32 column;
+                    for (; from < to; from = groupEnd) {
+                        groupEnd = std::min((from | 7) + 1, to);
+                        column = getColumnOffset(from);
+                        if (groupEnd - from == 8)
+                            std::memcpy(framebuffer + dstRow + column, previous + srcRow + column, 8 * sizeof(u16));
+                        else
+                            std::memcpy(framebuffer + dstRow + column, previous + srcRow + column, (groupEnd - from) * sizeof(u16));
+                    }
+                };
+                
+                // Copies rows [row, row + rows) where tiles of rows x tileWidth pixels are contiguous in both frames
+                const auto copyTiles = [&](const s32 row, const s32 rows, const s32 tileWidth) {
+                    const s32 tileX0 = (x0 + tileWidth - 1) & ~(tileWidth - 1);
+                    const s32 tileX1 = x1 & ~(tileWidth - 1);
+                    if (tileX0 >= tileX1)
+                        return false;
+                    
+                    u32 dstRow = this->getRowOffset(row);
+                    u32 srcRow = this->getRowOffset(row - dy);
+                    for (s32 px = tileX0; px < tileX1; px += tileWidth)
+                        std::memcpy(framebuffer + dstRow + getColumnOffset(px), previous + srcRow + getColumnOffset(px), rows * tileWidth * sizeof(u16));
+                    
+                    for (s32 tileRow = row; tileRow < row + rows; ++tileRow) {
+                        dstRow = this->getRowOffset(tileRow);
+                        srcRow = this->getRowOffset(tileRow - dy);
+                        copySpan(dstRow, srcRow, x0, tileX0);
+                        copySpan(dstRow, srcRow, tileX1, x1);
+                    }
+                    return true;
+                };
+                
+                // Moves that keep the row phase within a GOB (8 rows x 32 pixels) copy whole GOBs, moves that keep
+                // the row parity copy the 2 rows x 16 pixels runs a GOB is made of
+                for (s32 row = y0; row < y1; ) {
+                    if ((dy & 7) == 0 && (row & 7) == 0 && row + 8 <= y1 && copyTiles(row, 8, 32)) {
+                        row += 8;
+                    } else if ((dy & 1) == 0 && (row & 1) == 0 && row + 2 <= y1 && copyTiles(row, 2, 16)) {
+                        row += 2;
                     } else {
-                        ult::inPlot.store(false, std::memory_order_release);
+                        copySpan(this->getRowOffset(row), this->getRowOffset(row - dy), x0, x1);
+                        ++row;
                     }
-                    //ult::inPlot = false;
                 }
+                return true;
             }
 
-
             /**
              * @brief Draws a RGBA8888 bitmap from memory
              *
@@ -2199,104 +4829,120 @@ namespace tsl {
              * @param bmp Pointer to bitmap data
              */
             inline void drawBitmap(s32 x, s32 y, s32 w, s32 h, const u8 *bmp) {
+                
+                if (this->m_recording) [[unlikely]] {
+                    // Callers may pass temporary buffers, so the pixels travel with the command
+                    const u8* pixels = this->m_displayList.copy(bmp, static_cast<size_t>(w) * h * 4);
+                    const std::string_view bytes(reinterpret_cast<const char*>(pixels), static_cast<size_t>(w) * h * 4);
+                    this->record(y, y + h, DisplayList::hash("drawBitmap", x, y, w, h, bytes),
+                        [=](Renderer& renderer) { renderer.drawBitmap(x, y, w, h, pixels); });
+                    return;
+                }
                 if (w <= 0 || h <= 0) [[unlikely]] return;
                 
-                const u8* __restrict__ src = bmp;
+                const ClipRect clip = this->getClipRect();
+                const s32 x0 = std::max(x, clip.x0), x1 = std::min(x + w, clip.x1);
+                const s32 y0 = std::max(y, clip.y0), y1 = std::min(y + h, clip.y1);
+                if (x0 >= x1 || y0 >= y1) return;
                 
-                s32 px;
-
-                // Completely unroll small bitmaps for maximum speed
-                if (w <= 8 && h <= 8) [[likely]] {
-                    // Specialized path for small bitmaps (icons, etc.)
-                    for (s32 py = 0; py < h; ++py) {
-                        const s32 rowY = y + py;
-                        px = x;
+                // Same alpha rules as a(): opaque screenshots force full alpha, otherwise it is capped by the opacity
+                const bool forceOpaque = ult::disableTransparency && ult::useOpaqueScreenshots;
+                const u8 alphaLimit = a(Color(0xF000)).a;
+                
+                // Rows are converted to packed RGBA4444 in chunks, then blended with the bitmap kernel
+                constexpr s32 ChunkPixels = 256;
+                alignas(16) u8 converted[ChunkPixels * 2];
+                
+                for (s32 py = y0; py < y1; ++py) {
+                    const u8* const srcRow = bmp + (static_cast<size_t>(py - y) * w + (x0 - x)) * 4;
+                    
+                    for (s32 cx = x0; cx < x1; cx += ChunkPixels) {
+                        const s32 count = std::min(ChunkPixels, x1 - cx);
+                        ult::convertRGBA8888ToRGBA4444(srcRow + (cx - x0) * 4, converted, count);
                         
-                        // Unroll inner loop completely for small widths
-                        switch(w) {
-                            case 8: goto pixel8;
-                            case 7: goto pixel7;
-                            case 6: goto pixel6;
-                            case 5: goto pixel5;
-                            case 4: goto pixel4;
-                            case 3: goto pixel3;
-                            case 2: goto pixel2;
-                            case 1: goto pixel1;
-                            default: break;
+                        if (forceOpaque) {
+                            for (s32 i = 0; i < count; ++i)
+                                converted[i * 2 + 1] |= 0xF;
+                        } else if (alphaLimit < 0xF) {
+                            for (s32 i = 0; i < count; ++i) {
+                                u8& ba = converted[i * 2 + 1];
+                                ba = (ba & 0xF0) | std::min<u8>(ba & 0xF, alphaLimit);
+                            }
                         }
                         
-                        pixel8: {
-                            const Color c = {static_cast<u8>(src[0] >> 4), static_cast<u8>(src[1] >> 4), 
-                                           static_cast<u8>(src[2] >> 4), static_cast<u8>(src[3] >> 4)};
-                            setPixelBlendSrc(px++, rowY, a(c)); src += 4;
-                        }
-                        pixel7: {
-                            const Color c = {static_cast<u8>(src[0] >> 4), static_cast<u8>(src[1] >> 4), 
-                                           static_cast<u8>(src[2] >> 4), static_cast<u8>(src[3] >> 4)};
-                            setPixelBlendSrc(px++, rowY, a(c)); src += 4;
-                        }
-                        pixel6: {
-                            const Color c = {static_cast<u8>(src[0] >> 4), static_cast<u8>(src[1] >> 4), 
-                                           static_cast<u8>(src[2] >> 4), static_cast<u8>(src[3] >> 4)};
-                            setPixelBlendSrc(px++, rowY, a(c)); src += 4;
-                        }
-                        pixel5: {
-                            const Color c = {static_cast<u8>(src[0] >> 4), static_cast<u8>(src[1] >> 4), 
-                                           static_cast<u8>(src[2] >> 4), static_cast<u8>(src[3] >> 4)};
-                            setPixelBlendSrc(px++, rowY, a(c)); src += 4;
-                        }
-                        pixel4: {
-                            const Color c = {static_cast<u8>(src[0] >> 4), static_cast<u8>(src[1] >> 4), 
-                                           static_cast<u8>(src[2] >> 4), static_cast<u8>(src[3] >> 4)};
-                            setPixelBlendSrc(px++, rowY, a(c)); src += 4;
-                        }
-                        pixel3: {
-                            const Color c = {static_cast<u8>(src[0] >> 4), static_cast<u8>(src[1] >> 4), 
-                                           static_cast<u8>(src[2] >> 4), static_cast<u8>(src[3] >> 4)};
-                            setPixelBlendSrc(px++, rowY, a(c)); src += 4;
-                        }
-                        pixel2: {
-                            const Color c = {static_cast<u8>(src[0] >> 4), static_cast<u8>(src[1] >> 4), 
-                                           static_cast<u8>(src[2] >> 4), static_cast<u8>(src[3] >> 4)};
-                            setPixelBlendSrc(px++, rowY, a(c)); src += 4;
-                        }
-                        pixel1: {
-                            const Color c = {static_cast<u8>(src[0] >> 4), static_cast<u8>(src[1] >> 4), 
-                                           static_cast<u8>(src[2] >> 4), static_cast<u8>(src[3] >> 4)};
-                            setPixelBlendSrc(px, rowY, a(c)); src += 4;
-                        }
+                        this->forEachRowRun(clip, cx, cx + count, py, [&](u16* dst, s32 runX, s32 runLength) {
+                            blend::srcBitmap(dst, runLength, converted + (runX - cx) * 2);
+                        });
                     }
+                }
+            }
+            
+            /**
+             * @brief Draws a preconverted sprite
+             * @note Same output as drawBitmap with the sprite's source pixels.
+             *
+             * @param x X start position
+             * @param y Y start position
+             * @param sprite Sprite, kept alive until the frame has been presented
+             */
+            inline void drawSprite(const s32 x, const s32 y, const Sprite& sprite) {
+                if (this->m_recording) [[unlikely]] {
+                    const Sprite* const spritePtr = &sprite;
+                    this->record(y, y + sprite.m_height, DisplayList::hash("drawSprite", x, y, sprite.m_hash),
+                        [=](Renderer& renderer) { renderer.drawSprite(x, y, *spritePtr); });
                     return;
                 }
+                if (sprite.empty()) [[unlikely]] return;
+                
+                const ClipRect clip = this->getClipRect();
+                const s32 x0 = std::max(x, clip.x0), x1 = std::min(x + sprite.m_width, clip.x1);
+                const s32 y0 = std::max(y, clip.y0), y1 = std::min(y + sprite.m_height, clip.y1);
+                if (x0 >= x1 || y0 >= y1) return;
                 
-                // Fallback to vectorized version for larger bitmaps
-                const s32 vectorWidth = w & ~7; // Process 8 pixels at a time
-                const s32 remainder = w & 7;
+                const bool forceOpaque = ult::disableTransparency && ult::useOpaqueScreenshots;
+                const u8 alphaLimit = a(Color(0xF000)).a;
                 
-                for (s32 py = 0; py < h; ++py) {
-                    const s32 rowY = y + py;
-                    px = x;
+                // Altered alpha invalidates the run classification, so blend whole rows with adjusted copies
+                if (forceOpaque || alphaLimit < 0xF) [[unlikely]] {
+                    constexpr s32 ChunkPixels = 256;
+                    alignas(16) u8 adjusted[ChunkPixels * 2];
                     
-                    // Process 8 pixels at once (cache-friendly)
-                    for (s32 i = 0; i < vectorWidth; i += 8) {
-                        // Prefetch next cache line
-                        __builtin_prefetch(src + 64, 0, 3);
-                        
-                        // Process 8 pixels with minimal overhead
-                        for (int j = 0; j < 8; ++j) {
-                            const Color c = {static_cast<u8>(src[0] >> 4), static_cast<u8>(src[1] >> 4), 
-                                           static_cast<u8>(src[2] >> 4), static_cast<u8>(src[3] >> 4)};
-                            setPixelBlendSrc(px++, rowY, a(c));
-                            src += 4;
+                    for (s32 py = y0; py < y1; ++py) {
+                        const u8* const srcRow = sprite.m_pixels.data() + (static_cast<size_t>(py - y) * sprite.m_width + (x0 - x)) * 2;
+                        for (s32 cx = x0; cx < x1; cx += ChunkPixels) {
+                            const s32 count = std::min(ChunkPixels, x1 - cx);
+                            std::memcpy(adjusted, srcRow + (cx - x0) * 2, count * 2);
+                            for (s32 i = 0; i < count; ++i) {
+                                u8& ba = adjusted[i * 2 + 1];
+                                ba = forceOpaque ? (ba | 0xF) : ((ba & 0xF0) | std::min<u8>(ba & 0xF, alphaLimit));
+                            }
+                            this->forEachRowRun(clip, cx, cx + count, py, [&](u16* dst, s32 runX, s32 runLength) {
+                                blend::srcBitmap(dst, runLength, adjusted + (runX - cx) * 2);
+                            });
                         }
                     }
+                    return;
+                }
+                
+                for (s32 py = y0; py < y1; ++py) {
+                    const s32 row = py - y;
+                    const size_t rowStart = static_cast<size_t>(row) * sprite.m_width;
+                    const u8* const pixels = sprite.m_pixels.data() + rowStart * 2;
+                    const u16* const opaque = sprite.m_opaque.data() + rowStart;
                     
-                    // Handle remainder
-                    for (s32 i = 0; i < remainder; ++i) {
-                        const Color c = {static_cast<u8>(src[0] >> 4), static_cast<u8>(src[1] >> 4), 
-                                       static_cast<u8>(src[2] >> 4), static_cast<u8>(src[3] >> 4)};
-                        setPixelBlendSrc(px++, rowY, a(c));
-                        src += 4;
+                    for (u32 i = sprite.m_rowRuns[row]; i < sprite.m_rowRuns[row + 1]; ++i) {
+                        const Sprite::Run& run = sprite.m_runs[i];
+                        const s32 runStart = x + run.x;
+                        
+                        if (run.opaque) {
+                            this->forEachRowRun(clip, runStart, runStart + run.length, py, [&](u16* dst, s32 runX, s32 runLength) {
+                                blend::srcOpaque(dst, runLength, opaque + (runX - x));
+                            });
+                        } else {
+                            this->forEachRowRun(clip, runStart, runStart + run.length, py, [&](u16* dst, s32 runX, s32 runLength) {
+                                blend::srcBitmap(dst, runLength, pixels + (runX - x) * 2);
+                            });
+                        }
                     }
                 }
             }
@@ -2307,7 +4953,24 @@ namespace tsl {
              * @param color Color
              */
             inline void fillScreen(const Color& color) {
-                std::fill_n(static_cast<Color*>(this->getCurrentFramebuffer()), this->getFramebufferSize() / sizeof(Color), color);
+                if (this->m_recording) [[unlikely]] {
+                    // Fills ignore the scissor, so record against the whole framebuffer
+                    const ClipRect screen = { 0, 0, cfg::FramebufferWidth, cfg::FramebufferHeight };
+                    this->m_displayList.record(0, cfg::FramebufferHeight, screen, DisplayList::hash("fillScreen", color),
+                        [=](Renderer& renderer) { renderer.fillScreen(color); });
+                    return;
+                }
+                
+                if (s_replayClip) [[unlikely]] {
+                    const ClipRect clip = *s_replayClip;
+                    for (s32 y = clip.y0; y < clip.y1; ++y)
+                        this->fillSpan(clip, clip.x0, clip.x1, y, color);
+                    return;
+                }
+                
+                std::fill_n(static_cast<Color*>(this->getCurrentFramebuffer()), this->getTargetSize() / sizeof(Color), color);
+                if (this->m_linearTarget)
+                    this->markWritten(0, cfg::FramebufferWidth, 0, cfg::FramebufferHeight);
             }
             
             /**
@@ -2341,41 +5004,57 @@ namespace tsl {
                                                   const std::vector<std::string>* specialSymbols = nullptr,
                                                   const u32 highlightStartChar = 0,
                                                   const u32 highlightEndChar = 0) {
+                TSL_PROFILE_PHASE(Text);
+                
+                if (draw && this->m_recording) [[unlikely]] {
+                    // Lay the text out and pin its glyphs now, workers only blit them when the display list is flushed.
+                    // Glyph lookups could insert and evict concurrently, freeing glyphs another band is drawing.
+                    auto text = std::make_shared<RecordedText>();
+                    this->m_recording = false;
+                    this->m_textSink = text.get();
+                    const auto dimensions = this->drawString(originalString, monospace, x, y, fontSize, defaultColor, maxWidth, true,
+                                                             highlightColor, specialSymbols, highlightStartChar, highlightEndChar);
+                    this->m_textSink = nullptr;
+                    this->m_recording = true;
+                    
+                    const bool hasHighlightColor = highlightColor != nullptr;
+                    const Color highlight = hasHighlightColor ? *highlightColor : defaultColor;
+                    const std::vector<std::string> symbols = specialSymbols ? *specialSymbols : std::vector<std::string>{};
+                    
+                    // Glyphs can reach about one font size above the pen position and below the measured height
+                    const u64 hash = DisplayList::hash("drawString", originalString, monospace, x, y, fontSize, defaultColor, maxWidth,
+                                                       hasHighlightColor, highlight, symbols, highlightStartChar, highlightEndChar);
+                    this->record(y - static_cast<s32>(fontSize), y + dimensions.second + static_cast<s32>(fontSize), hash,
+                        [text = std::move(text), x, y, defaultColor](Renderer& renderer) {
+                            if (text->sprite)
+                                renderer.drawTextSprite(*text->sprite, x, y, defaultColor);
+                            for (const auto& placed : text->glyphs)
+                                renderer.renderGlyph(placed.glyph, placed.x, placed.y, placed.color);
+                        });
+                    return dimensions;
+                }
                 
                 // Thread-safe translation cache access
-                std::string text;
-                #ifdef UI_OVERRIDE_PATH
-                {
-                    std::shared_lock<std::shared_mutex> readLock(s_translationCacheMutex);
-                    auto translatedIt = ult::translationCache.find(originalString);
-                    if (translatedIt != ult::translationCache.end()) {
-                        text = translatedIt->second;
-                    } else {
-                        // Need to upgrade to write lock
-                        readLock.unlock();
-                        std::unique_lock<std::shared_mutex> writeLock(s_translationCacheMutex);
-                        
-                        // Double-check pattern
-                        translatedIt = ult::translationCache.find(originalString);
-                        if (translatedIt != ult::translationCache.end()) {
-                            text = translatedIt->second;
-                        } else {
-                            ult::translationCache[originalString] = originalString;
-                            text = originalString;
-                        }
-                    }
-                }
-                #else
-                text = originalString;
-                #endif
+                const std::string text = getTranslatedText(originalString);
                 
                 if (text.empty() || fontSize == 0) return {0, 0};
                 
-                const float maxWidthLimit = maxWidth > 0 ? x + maxWidth : std::numeric_limits<float>::max();
-                
                 // Check if highlighting is enabled (both highlight color and delimiters must be provided)
                 const bool highlightingEnabled = highlightColor && highlightStartChar != 0 && highlightEndChar != 0;
                 
+                // Plain single-color runs can come from the prerendered sprite cache
+                if (draw && maxWidth <= 0 && !highlightingEnabled && !specialSymbols && TextSpriteCache::isEnabled()) {
+                    auto sprite = TextSpriteCache::get(text, fontSize, monospace);
+                    const std::pair<s32, s32> dimensions = {sprite->layoutWidth, sprite->layoutHeight};
+                    if (this->m_textSink) [[unlikely]]
+                        this->m_textSink->sprite = std::move(sprite);
+                    else
+                        drawTextSprite(*sprite, x, y, defaultColor);
+                    return dimensions;
+                }
+                
+                const float maxWidthLimit = maxWidth > 0 ? x + maxWidth : std::numeric_limits<float>::max();
+                
                 // Fast ASCII check with early exit
                 bool isAsciiOnly = true;
                 const char* textPtr = text.data();
@@ -2396,6 +5075,7 @@ namespace tsl {
                 u32 currCharacter;
                 ssize_t codepointWidth;
                 FontManager::Glyph* glyph;
+                std::vector<u64>* const glyphPins = this->m_textSink ? &this->m_pinnedGlyphs : nullptr;
                 bool symbolProcessed;
                 size_t remainingLength;
                 u32 symChar;
@@ -2428,7 +5108,7 @@ namespace tsl {
                         }
                         
                         // Get glyph (now thread-safe)
-                        glyph = FontManager::getOrCreateGlyph(currCharacter, monospace, fontSize);
+                        glyph = FontManager::getOrCreateGlyph(currCharacter, monospace, fontSize, glyphPins);
                         if (!glyph) continue;
                         
                         // Track maximum Y position reached (y position + glyph height)
@@ -2436,7 +5116,7 @@ namespace tsl {
                         
                         // Render if needed
                         if (draw && glyph->glyphBmp && currCharacter > 32) { // Space is 32
-                            renderGlyph(glyph, currX, currY, *currentColor);
+                            emitGlyph(glyph, currX, currY, *currentColor);
                         }
                         
                         currX += static_cast<s32>(glyph->xAdvance * glyph->currFontSize);
@@ -2466,13 +5146,13 @@ namespace tsl {
                                             currX = x;
                                             currY += static_cast<s32>(fontSize);
                                         } else {
-                                            glyph = FontManager::getOrCreateGlyph(symChar, monospace, fontSize);
+                                            glyph = FontManager::getOrCreateGlyph(symChar, monospace, fontSize, glyphPins);
                                             if (glyph) {
                                                 // Track maximum Y position reached
                                                 maxY = std::max(maxY, currY + static_cast<s32>(glyph->height));
                                                 
                                                 if (draw && glyph->glyphBmp && symChar > 32) {
-                                                    renderGlyph(glyph, currX, currY, *highlightColor);
+                                                    emitGlyph(glyph, currX, currY, *highlightColor);
                                                 }
                                                 currX += static_cast<s32>(glyph->xAdvance * glyph->currFontSize);
                                             }
@@ -2519,7 +5199,7 @@ namespace tsl {
                         }
                         
                         // Get glyph (now thread-safe)
-                        glyph = FontManager::getOrCreateGlyph(currCharacter, monospace, fontSize);
+                        glyph = FontManager::getOrCreateGlyph(currCharacter, monospace, fontSize, glyphPins);
                         if (!glyph) continue;
                         
                         // Track maximum Y position reached
@@ -2527,7 +5207,7 @@ namespace tsl {
                         
                         // Render if needed
                         if (draw && glyph->glyphBmp && currCharacter > 32) {
-                            renderGlyph(glyph, currX, currY, *currentColor);
+                            emitGlyph(glyph, currX, currY, *currentColor);
                         }
                         
                         currX += static_cast<s32>(glyph->xAdvance * glyph->currFontSize);
@@ -2561,7 +5241,11 @@ namespace tsl {
             // Calculate string dimensions without drawing
             inline std::pair<s32, s32> getTextDimensions(const std::string& text, bool monospace, 
                                                          const u32 fontSize, const ssize_t maxWidth = 0) {
-                return drawString(text, monospace, 0, 0, fontSize, Color{0,0,0,0}, maxWidth, false);
+                if (maxWidth > 0)
+                    return drawString(text, monospace, 0, 0, fontSize, Color{0,0,0,0}, maxWidth, false);
+                
+                const auto layout = TextLayoutCache::get(getTranslatedText(text), fontSize, monospace);
+                return {layout->width, layout->height};
             }
             
             // Thread-safe limitStringLength using the unified cache
@@ -2569,31 +5253,7 @@ namespace tsl {
                                                const u32 fontSize, const s32 maxLength) {  // Changed fontSize to u32
                 
                 // Thread-safe translation cache access
-                std::string text;
-                #ifdef UI_OVERRIDE_PATH
-                {
-                    std::shared_lock<std::shared_mutex> readLock(s_translationCacheMutex);
-                    auto translatedIt = ult::translationCache.find(originalString);
-                    if (translatedIt != ult::translationCache.end()) {
-                        text = translatedIt->second;
-                    } else {
-                        // Need to upgrade to write lock
-                        readLock.unlock();
-                        std::unique_lock<std::shared_mutex> writeLock(s_translationCacheMutex);
-                        
-                        // Double-check pattern
-                        translatedIt = ult::translationCache.find(originalString);
-                        if (translatedIt != ult::translationCache.end()) {
-                            text = translatedIt->second;
-                        } else {
-                            ult::translationCache[originalString] = originalString;
-                            text = originalString;
-                        }
-                    }
-                }
-                #else
-                text = originalString;
-                #endif
+                const std::string text = getTranslatedText(originalString);
                 
                 if (text.size() < 2) return text;
                 
@@ -2610,57 +5270,15 @@ namespace tsl {
                     return "…"; // If there's no room for text, just return ellipsis
                 }
                 
-                // Calculate width incrementally
-                s32 currX = 0;
-                auto itStr = text.cbegin();
-                const auto itStrEnd = text.cend();
-                auto lastValidPos = itStr;
-                
-                // Fast ASCII check
-                bool isAsciiOnly = true;
-                for (unsigned char c : text) {
-                    if (c > 127) {
-                        isAsciiOnly = false;
-                        break;
-                    }
-                }
-                
-                // Move variable declarations outside the loop
-                u32 currCharacter;
-                ssize_t codepointWidth;
-                
-                while (itStr != itStrEnd) {
-                    // Decode UTF-8 codepoint
-                    if (isAsciiOnly) {
-                        currCharacter = static_cast<u32>(*itStr);
-                        codepointWidth = 1;
-                    } else {
-                        codepointWidth = decode_utf8(&currCharacter, reinterpret_cast<const u8*>(&(*itStr)));
-                        if (codepointWidth <= 0) break;
-                    }
-                    
-                    // FontManager::getOrCreateGlyph is now thread-safe
-                    FontManager::Glyph* glyph = FontManager::getOrCreateGlyph(currCharacter, monospace, fontSize);
-                    if (!glyph) {
-                        itStr += codepointWidth;
-                        continue;
-                    }
-                    
-                    // Fixed: Use consistent s32 calculation
-                    s32 charWidth = static_cast<s32>(glyph->xAdvance * glyph->currFontSize);
-                    
-                    if (currX + charWidth > maxWidthWithoutEllipsis) {
-                        // Calculate the byte position for substring
-                        size_t bytePos = std::distance(text.cbegin(), lastValidPos);
-                        return text.substr(0, bytePos) + "…";
-                    }
-                    
-                    currX += charWidth;
-                    itStr += codepointWidth;
-                    lastValidPos = itStr;
-                }
+                // Binary search the cached advance prefix sums for the last codepoint that still fits
+                const auto layout = TextLayoutCache::get(text, fontSize, monospace);
+                const auto& prefix = layout->advancePrefix;
+                const auto overflow = std::upper_bound(prefix.begin() + 1, prefix.end(), maxWidthWithoutEllipsis);
+                if (overflow == prefix.end())
+                    return text;
                 
-                return text;
+                const size_t fittingCodepoints = std::distance(prefix.begin(), overflow) - 1;
+                return text.substr(0, layout->byteOffsets[fittingCodepoints]) + "…";
             }
 
             inline void setLayerPos(u32 x, u32 y) {
@@ -2702,105 +5320,182 @@ namespace tsl {
 
 
             #if USING_WIDGET_DIRECTIVE
-            // Method to draw clock, temperatures, and battery percentage
+            /**
+             * @brief Draws the clock, temperatures and battery percentage
+             * @note Sensors are sampled in the background by tsl::widget. Strings are formatted and measured only
+             *       when their value changes. Over a background drawStaticBackground() knows, the finished widget
+             *       is copied back from the last frame that drew the same content instead of drawn again.
+             */
             inline void drawWidget() {
-                // Draw clock if it's not hidden
                 static time_t lastTimeUpdate = 0;
                 static char timeStr[20]; // Allocate a buffer to store the time string
-                size_t y_offset = 45;
-            
-                if (!(ult::hideBattery && ult::hidePCBTemp && ult::hideSOCTemp && ult::hideClock)) {
-                    drawRect(245, 23, 1, 49, a(separatorColor));
-                }
-            
+                s32 y_offset = 45;
+                
+                const bool drawSeparator = !(ult::hideBattery && ult::hidePCBTemp && ult::hideSOCTemp && ult::hideClock);
                 if ((ult::hideBattery && ult::hidePCBTemp && ult::hideSOCTemp) || ult::hideClock) {
                     y_offset += 10;
                 }
-            
-                // Use simpler time() function instead of clock_gettime for seconds precision
-                time_t currentTime = time(nullptr);
-                if (!ult::hideClock) {
-                    // Only update time string if a second has passed
-                    if (currentTime != lastTimeUpdate) {
-                        strftime(timeStr, sizeof(timeStr), ult::datetimeFormat.c_str(), localtime(&currentTime));
-                        ult::localizeTimeStr(timeStr);
-                        lastTimeUpdate = currentTime;
-                    }
-                    auto [timeWidth, timeHeight] = getTextDimensions(timeStr, false, 20);
-                    drawString(timeStr, false, tsl::cfg::FramebufferWidth - timeWidth - 20, y_offset, 20, a(clockColor));
-                    y_offset += 22;
+                
+                // The sampler runs since the screen was set up, it only needs to hear about changed settings
+                static u32 lastSensors = UINT32_MAX;
+                if (const u32 sensors = widget::getShownSensors(); sensors != lastSensors) {
+                    widget::setSensors(sensors);
+                    lastSensors = sensors;
                 }
-            
-                // Draw temperatures and battery percentage
-                static char PCB_temperatureStr[10];
-                static char SOC_temperatureStr[10];
-                static char chargeString[6];
-            
-                size_t statusChange = size_t(ult::hideSOCTemp) + size_t(ult::hidePCBTemp) + size_t(ult::hideBattery);
-                static size_t lastStatusChange = 0;
-                static time_t lastSensorUpdate = 0;
                 
-                // Update sensors every second or when visibility settings change
-                if ((currentTime - lastSensorUpdate) >= 1 || statusChange != lastStatusChange) {
-                    if (!ult::hideSOCTemp) {
-                        ult::ReadSocTemperature(&ult::SOC_temperature);
-                        snprintf(SOC_temperatureStr, sizeof(SOC_temperatureStr) - 1, "%d°C", static_cast<int>(round(ult::SOC_temperature)));
-                    } else {
-                        __builtin_strcpy(SOC_temperatureStr, "");
-                        ult::SOC_temperature = 0;
-                    }
-                    
-                    if (!ult::hidePCBTemp) {
-                        ult::ReadPcbTemperature(&ult::PCB_temperature);
-                        snprintf(PCB_temperatureStr, sizeof(PCB_temperatureStr) - 1, "%d°C", static_cast<int>(round(ult::PCB_temperature)));
-                    } else {
-                        __builtin_strcpy(PCB_temperatureStr, "");
-                        ult::PCB_temperature = 0;
-                    }
-                    
-                    if (!ult::hideBattery) {
-                        ult::powerGetDetails(&ult::batteryCharge, &ult::isCharging);
-                        ult::batteryCharge = std::min(ult::batteryCharge, 100U);
-                        sprintf(chargeString, "%d%%", ult::batteryCharge);
-                    } else {
-                        __builtin_strcpy(chargeString, "");
-                        ult::batteryCharge = 0;
-                    }
+                // Use simpler time() function instead of clock_gettime for seconds precision
+                const time_t currentTime = time(nullptr);
+                if (!ult::hideClock && currentTime != lastTimeUpdate) {
+                    strftime(timeStr, sizeof(timeStr), ult::datetimeFormat.c_str(), localtime(&currentTime));
+                    ult::localizeTimeStr(timeStr);
+                    lastTimeUpdate = currentTime;
+                }
+                
+                // Format the readings once per sample
+                if (widget::getGeneration() != this->m_widgetSensorGeneration) {
+                    widget::SensorReadings readings;
+                    this->m_widgetSensorGeneration = widget::getReadings(readings);
+                    ult::SOC_temperature = readings.socTemperature;
+                    ult::PCB_temperature = readings.pcbTemperature;
+                    ult::batteryCharge = readings.batteryCharge;
+                    ult::isCharging = readings.isCharging;
                     
-                    lastSensorUpdate = currentTime;
-                    lastStatusChange = statusChange;
-                }
+                    char buffer[10];
+                    snprintf(buffer, sizeof(buffer) - 1, "%d°C", static_cast<int>(round(ult::SOC_temperature)));
+                    this->setWidgetText(this->m_widgetSoc, buffer);
+                    snprintf(buffer, sizeof(buffer) - 1, "%d°C", static_cast<int>(round(ult::PCB_temperature)));
+                    this->setWidgetText(this->m_widgetPcb, buffer);
+                    snprintf(buffer, sizeof(buffer), "%d%%", ult::batteryCharge);
+                    this->setWidgetText(this->m_widgetCharge, buffer);
+                }
+                
+                // Lay out the strings, the battery percentage rightmost and the temperatures left of it
+                struct WidgetString {
+                    const WidgetText* text;
+                    s32 x, y;
+                    Color color = { 0 };
+                };
+                WidgetString strings[4];
+                size_t stringCount = 0;
                 
-                // Calculate string widths only when needed
-                s32 chargeWidth = 0, pcbWidth = 0, socWidth = 0;
+                if (!ult::hideClock) {
+                    this->setWidgetText(this->m_widgetClock, timeStr);
+                    strings[stringCount++] = { &this->m_widgetClock, static_cast<s32>(tsl::cfg::FramebufferWidth) - this->m_widgetClock.width - 20,
+                                               y_offset, a(clockColor) };
+                    y_offset += 22;
+                }
                 
-                // Draw battery percentage
+                s32 chargeWidth = 0, pcbWidth = 0;
                 if (!ult::hideBattery && ult::batteryCharge > 0) {
                     Color batteryColorToUse = ult::isCharging ? tsl::Color(0x0, 0xF, 0x0, 0xF) : 
                                             (ult::batteryCharge < 20 ? tsl::Color(0xF, 0x0, 0x0, 0xF) : batteryColor);
-                    auto [width, height] = getTextDimensions(chargeString, false, 20);
-                    chargeWidth = width;
-                    drawString(chargeString, false, tsl::cfg::FramebufferWidth - chargeWidth - 20, y_offset, 20, a(batteryColorToUse));
+                    chargeWidth = this->m_widgetCharge.width;
+                    strings[stringCount++] = { &this->m_widgetCharge, static_cast<s32>(tsl::cfg::FramebufferWidth) - chargeWidth - 20,
+                                               y_offset, a(batteryColorToUse) };
                 }
-            
-                // Draw PCB and SOC temperatures
+                
                 int offset = 0;
                 if (!ult::hidePCBTemp && ult::PCB_temperature > 0) {
                     if (!ult::hideBattery)
                         offset -= 5;
-                    auto [width, height] = getTextDimensions(PCB_temperatureStr, false, 20);
-                    pcbWidth = width;
-                    drawString(PCB_temperatureStr, false, tsl::cfg::FramebufferWidth + offset - pcbWidth - chargeWidth - 20, y_offset, 20, a(tsl::GradientColor(ult::PCB_temperature)));
+                    pcbWidth = this->m_widgetPcb.width;
+                    strings[stringCount++] = { &this->m_widgetPcb, static_cast<s32>(tsl::cfg::FramebufferWidth) + offset - pcbWidth - chargeWidth - 20,
+                                               y_offset, a(tsl::GradientColor(ult::PCB_temperature)) };
                 }
-            
+                
                 if (!ult::hideSOCTemp && ult::SOC_temperature > 0) {
                     if (!ult::hidePCBTemp || !ult::hideBattery)
                         offset -= 5;
-                    auto [width, height] = getTextDimensions(SOC_temperatureStr, false, 20);
-                    socWidth = width;
-                    drawString(SOC_temperatureStr, false, tsl::cfg::FramebufferWidth + offset - socWidth - pcbWidth - chargeWidth - 20, y_offset, 20, a(tsl::GradientColor(ult::SOC_temperature)));
+                    strings[stringCount++] = { &this->m_widgetSoc, static_cast<s32>(tsl::cfg::FramebufferWidth) + offset - this->m_widgetSoc.width - pcbWidth - chargeWidth - 20,
+                                               y_offset, a(tsl::GradientColor(ult::SOC_temperature)) };
+                }
+                
+                // Everything the widget touches, with the glyph margins the display list records text with
+                const Color separator = a(separatorColor);
+                u64 key = DisplayList::hash("widget", this->m_frameBackgroundKey, drawSeparator, separator);
+                ClipRect region = { 245, 23, static_cast<s32>(tsl::cfg::FramebufferWidth), 23 + 49 };
+                for (size_t i = 0; i < stringCount; ++i) {
+                    const auto& string = strings[i];
+                    key = DisplayList::combine(key, DisplayList::hash("", string.text->text, string.x, string.y, string.color));
+                    region.x0 = std::min(region.x0, string.x - 20);
+                    region.y0 = std::min(region.y0, string.y - 20);
+                    region.y1 = std::max(region.y1, string.y + string.text->height + 20);
+                }
+                region.x0 = std::max(region.x0, 0);
+                region.y0 = std::max(region.y0, 0);
+                region.y1 = std::min<s32>(region.y1, tsl::cfg::FramebufferHeight);
+                
+                // The widget is drawn right after the background, so over a known background its pixels repeat
+                const bool reusable = this->m_frameBackgroundKey != 0 && !this->m_recording && this->m_scissoringStack.empty();
+                if (reusable && (key | 1) == this->m_widgetRegionKey) {
+                    this->copyWidgetRegion(false);
+                    return;
+                }
+                
+                if (drawSeparator) {
+                    drawRect(245, 23, 1, 49, separator);
+                }
+                for (size_t i = 0; i < stringCount; ++i) {
+                    const auto& string = strings[i];
+                    drawString(string.text->text, false, string.x, string.y, 20, string.color);
+                }
+                
+                this->m_widgetRegionKey = 0;
+                if (reusable) {
+                    this->m_widgetRegion = region;
+                    this->m_widgetRegionPixels.resize(static_cast<size_t>(region.x1 - region.x0) * (region.y1 - region.y0));
+                    this->copyWidgetRegion(true);
+                    this->m_widgetRegionKey = key | 1;
+                }
+            }
+            
+        private:
+            struct WidgetText {
+                std::string text;
+                s32 width = 0;
+                s32 height = 0;
+                u32 fontGeneration = UINT32_MAX;
+            };
+            
+            WidgetText m_widgetClock, m_widgetCharge, m_widgetPcb, m_widgetSoc;
+            u32 m_widgetSensorGeneration = UINT32_MAX;
+            
+            // Pixels of the last widget drawn over a known background
+            u64 m_widgetRegionKey = 0;
+            ClipRect m_widgetRegion = { 0, 0, 0, 0 };
+            std::vector<u16> m_widgetRegionPixels;
+            
+            /**
+             * @brief Updates a widget string, measuring it only when it or the fonts changed
+             */
+            inline void setWidgetText(WidgetText& cached, const char* text) {
+                const u32 generation = FontManager::getGeneration();
+                if (cached.fontGeneration == generation && cached.text == text)
+                    return;
+                
+                cached.text = text;
+                std::tie(cached.width, cached.height) = getTextDimensions(cached.text, false, 20);
+                cached.fontGeneration = generation;
+            }
+            
+            /**
+             * @brief Saves the widget region of the current frame, or puts the saved pixels back
+             */
+            void copyWidgetRegion(const bool save) {
+                const ClipRect region = this->m_widgetRegion;
+                const s32 width = region.x1 - region.x0;
+                for (s32 y = region.y0; y < region.y1; ++y) {
+                    u16* const saved = this->m_widgetRegionPixels.data() + static_cast<size_t>(y - region.y0) * width - region.x0;
+                    this->forEachRowRun(region, region.x0, region.x1, y, [saved, save](u16* dst, s32 x, s32 runLength) {
+                        if (save)
+                            std::memcpy(saved + x, dst, runLength * sizeof(u16));
+                        else
+                            std::memcpy(dst, saved + x, runLength * sizeof(u16));
+                    });
                 }
             }
+            
+        public:
             #endif
 
             // Single unified glyph cache for all text operations
@@ -2815,6 +5510,28 @@ namespace tsl {
                 return FontManager::selectFontForCharacter(character);
             }
             
+            // Glyph placed by a recorded drawString; evictable glyphs stay pinned until the display list is flushed
+            struct PlacedGlyph {
+                const FontManager::Glyph* glyph;
+                s32 x, y;
+                Color color;
+            };
+            
+            // Result of laying out a recorded drawString: either a cached text sprite or its glyphs
+            struct RecordedText {
+                std::shared_ptr<const TextSpriteCache::Sprite> sprite;
+                std::vector<PlacedGlyph> glyphs;
+            };
+            
+            // Draws a glyph, or collects it while drawString is being recorded
+            inline void emitGlyph(const FontManager::Glyph* glyph, s32 x, s32 y, const Color& color) {
+                if (this->m_textSink) [[unlikely]] {
+                    this->m_textSink->glyphs.push_back({ glyph, x, y, color });
+                    return;
+                }
+                this->renderGlyph(glyph, x, y, color);
+            }
+            
             // Optimized glyph rendering
             inline void renderGlyph(const FontManager::Glyph* glyph, float x, float y, const Color& color) {
                 if (!glyph->glyphBmp || color.a == 0) return;
@@ -2826,59 +5543,84 @@ namespace tsl {
                 if (xPos >= cfg::FramebufferWidth || yPos >= cfg::FramebufferHeight ||
                     xPos + glyph->width <= 0 || yPos + glyph->height <= 0) return;
                 
-                // Calculate clipping
-                const s32 startX = std::max(0, -xPos);
-                const s32 startY = std::max(0, -yPos);
-                const s32 endX = std::min(glyph->width, static_cast<s32>(cfg::FramebufferWidth) - xPos);
-                const s32 endY = std::min(glyph->height, static_cast<s32>(cfg::FramebufferHeight) - yPos);
-                
-                // Move variable declarations outside loops
-                const s32 simdEnd = std::min(endX, (startX + 7) & ~7);
-                s32 bmpX;
-                uint8_t alpha;
-                s32 pixelX;
-                Color tmpColor = {0};
+                const u8* const glyphBmp = glyph->glyphBmp;
+                const s32 glyphWidth = glyph->width;
+                this->blitAlphaRuns(glyph->runs, xPos, yPos, color, [glyphBmp, glyphWidth](s32 bmpX, s32 bmpY) -> u8 {
+                    return glyphBmp[bmpY * glyphWidth + bmpX] >> 4;
+                });
+            }
+            
+            /**
+             * @brief Blits a prerendered text sprite, matching renderGlyph's blending
+             * @note Clipping against the scissor and framebuffer is resolved once per sprite,
+             *       so the inner loop only addresses and blends covered pixels.
+             *
+             * @param sprite Sprite from TextSpriteCache
+             * @param x X pos of the drawString origin
+             * @param y Y pos of the drawString origin
+             * @param color Text color
+             */
+            inline void drawTextSprite(const TextSpriteCache::Sprite& sprite, s32 x, s32 y, const Color& color) {
+                if (sprite.runs.empty() || color.a == 0) return;
+                
+                this->blitAlphaRuns(sprite.runs, x + sprite.offsetX, y + sprite.offsetY, color, [&sprite](s32 bmpX, s32 bmpY) {
+                    return sprite.alphaAt(bmpX, bmpY);
+                });
+            }
+            
+            /**
+             * @brief Blits a run-length encoded alpha bitmap in a solid color
+             * @note Clipping against the framebuffer and scissor is resolved once; transparent runs are
+             *       never visited, opaque runs are stored directly and only partial-alpha runs are blended.
+             *
+             * @param runs Row runs of the bitmap
+             * @param originX X pos of the bitmap's top-left corner
+             * @param originY Y pos of the bitmap's top-left corner
+             * @param color Fill color
+             * @param alphaAt Callable (bmpX, bmpY) -> 4-bit alpha, only queried inside blended runs
+             */
+            template<typename AlphaAt>
+            inline void blitAlphaRuns(const AlphaRuns& runs, s32 originX, s32 originY, const Color& color, AlphaAt&& alphaAt) {
+                if (runs.empty()) return;
+                
+                const ClipRect clip = this->getClipRect();
+                
+                const s32 rows = static_cast<s32>(runs.rowStart.size()) - 1;
+                const s32 startRow = std::max(0, clip.y0 - originY);
+                const s32 endRow = std::min(rows, clip.y1 - originY);
+                if (startRow >= endRow) return;
+                
+                s32 pixelY;
+                u8 alpha;
                 
-                // Render with optimized inner loop
-                const uint8_t* bmpPtr = glyph->glyphBmp + startY * glyph->width;
-                for (s32 bmpY = startY; bmpY < endY; ++bmpY) {
-                    const s32 pixelY = yPos + bmpY;
-                    bmpX = startX;
-                    
-                    // Process 8 pixels at once
-                    for (; bmpX < simdEnd; ++bmpX) {
-                        alpha = bmpPtr[bmpX] >> 4;
-                        if (alpha) {
-                            pixelX = xPos + bmpX;
-                            if (alpha == 0xF) {
-                                this->setPixel(pixelX, pixelY, color, this->getPixelOffset(pixelX, pixelY));
-                            } else {
-                                tmpColor = color;
-                                tmpColor.a = alpha;
-                                this->setPixelBlendDst(pixelX, pixelY, tmpColor);
-                            }
-                        }
-                    }
+                for (s32 bmpY = startRow; bmpY < endRow; ++bmpY) {
+                    pixelY = originY + bmpY;
+                    const AlphaRuns::Run* run = runs.runs.data() + runs.rowStart[bmpY];
+                    const AlphaRuns::Run* const rowEnd = runs.runs.data() + runs.rowStart[bmpY + 1];
                     
-                    // Process remaining pixels
-                    for (; bmpX < endX; ++bmpX) {
-                        alpha = bmpPtr[bmpX] >> 4;
-                        if (alpha) {
-                            pixelX = xPos + bmpX;
-                            if (alpha == 0xF) {
-                                this->setPixel(pixelX, pixelY, color, this->getPixelOffset(pixelX, pixelY));
-                            } else {
-                                tmpColor = color;
-                                tmpColor.a = alpha;
-                                this->setPixelBlendDst(pixelX, pixelY, tmpColor);
-                            }
+                    for (; run != rowEnd; ++run) {
+                        if (run->opaque) {
+                            this->fillSpan(clip, originX + run->start, originX + run->start + run->length, pixelY, color);
+                            continue;
                         }
+                        
+                        this->forEachRowRun(clip, originX + run->start, originX + run->start + run->length, pixelY,
+                            [&](u16* dst, s32 pixelX, s32 runLength) {
+                                for (s32 i = 0; i < runLength; ++i) {
+                                    alpha = alphaAt(pixelX + i - originX, bmpY);
+                                    const Color src(dst[i]);
+                                    dst[i] = Color(
+                                        blendColor(src.r, color.r, alpha),
+                                        blendColor(src.g, color.g, alpha),
+                                        blendColor(src.b, color.b, alpha),
+                                        static_cast<u8>(alpha + (src.a * (0xF - alpha) >> 4))
+                                    ).rgba;
+                                }
+                            });
                     }
-                    bmpPtr += glyph->width;
                 }
             }
 
-            
         private:
             Renderer() {
                 updateDrawFunction();
@@ -2896,6 +5638,8 @@ namespace tsl {
             }
             
             bool m_initialized = false;
+            bool m_headless = false;
+            HeadlessFramebuffer m_headlessFramebuffer;
             ViDisplay m_display;
             ViLayer m_layer;
             Event m_vsyncEvent;
@@ -2905,6 +5649,57 @@ namespace tsl {
             void *m_currentFramebuffer = nullptr;
             
             std::stack<ScissoringConfig> m_scissoringStack;
+            std::vector<u32> m_rowOffsets;
+            RenderWorkerPool m_workerPool;
+            
+            std::vector<u16> m_backgroundLayer;
+            u64 m_backgroundKey = 0;
+            
+            // What drawStaticBackground painted this frame, for restoreBackground()
+            u64 m_frameBackgroundKey = 0;
+            bool m_frameBackgroundFromLayer = false;
+            Color m_frameBackgroundColor = { 0 };
+            std::vector<StaticRect> m_frameBackgroundChrome;
+            
+            u32 m_frameNumber = 0;
+            u8 m_lastPresentedSlot = 0;
+            
+            // Linear draw target, swizzled into m_presentFramebuffer by endFrame
+            std::vector<u16> m_backBuffer;
+            u32 m_backBufferStride = 0;
+            bool m_linearTarget = false;
+            void* m_presentFramebuffer = nullptr;
+            u32 m_lastPresentTileCount = 0;
+            
+            // Damage of the linear back buffer, one mask of GOB columns (32 pixels each) per GOB row (8 rows). Bands
+            // are whole GOB rows, so the replay workers never share a mask.
+            std::vector<u32> m_frameDamage;
+            // GOBs every framebuffer slot still has to receive from the back buffer, slot after slot
+            std::vector<u32> m_slotDamage;
+            inline static bool s_linearBackBufferEnabled = false;
+            
+            static constexpr size_t RoundedRectMaskCacheSize = 16;
+            std::vector<std::shared_ptr<const RoundedRectMask>> m_roundedRectMasks;
+            
+            DisplayList m_displayList;
+            bool m_recording = false;
+            RecordedText* m_textSink = nullptr;   // Collects glyphs while a drawString is being recorded
+            std::vector<u64> m_pinnedGlyphs;      // Glyphs the recorded display list draws, unpinned after the flush
+            bool m_releasePlotOnFlush = false;
+            inline static bool s_displayListEnabled = false;
+            inline static bool s_partialRedrawEnabled = false;
+            
+            // Per framebuffer slot, the signature of every band as it was last rasterized (0 = unknown)
+            std::vector<u64> m_slotBandSignatures;
+            std::vector<u64> m_bandSignatures;
+            std::vector<s32> m_redrawBands;
+            u32 m_lastRedrawBandCount = 0;
+            
+            // Rows per rasterization band when flushing the display list
+            static constexpr s32 DisplayListBandHeight = 32;
+            
+            // Band clip of the command being replayed on this thread, overrides the scissor stack
+            inline static thread_local const ClipRect* s_replayClip = nullptr;
             
 
             static inline float s_opacity = 1.0F;
@@ -2925,24 +5720,53 @@ namespace tsl {
              * @return Next framebuffer address
              */
             inline void* getNextFramebuffer() {
+                if (this->m_headless)
+                    return this->m_headlessFramebuffer.slotData(this->getNextFramebufferSlot());
                 return static_cast<u8*>(this->m_framebuffer.buf) + this->getNextFramebufferSlot() * this->getFramebufferSize();
             }
             
+            /**
+             * @brief Get the address of a framebuffer slot
+             *
+             * @param slot Slot
+             * @return Framebuffer address
+             */
+            inline void* getFramebufferSlotData(const u8 slot) {
+                if (this->m_headless)
+                    return this->m_headlessFramebuffer.slotData(slot);
+                return static_cast<u8*>(this->m_framebuffer.buf) + slot * this->getFramebufferSize();
+            }
+            
             /**
              * @brief Get the framebuffer size
              *
              * @return Framebuffer size
              */
             inline size_t getFramebufferSize() {
+                if (this->m_headless)
+                    return this->m_headlessFramebuffer.size();
                 return this->m_framebuffer.fb_size;
             }
             
+            /**
+             * @brief Size of the buffer primitives draw into, the linear back buffer or a framebuffer slot
+             *
+             * @return Size in bytes
+             */
+            inline size_t getTargetSize() {
+                if (this->m_linearTarget)
+                    return this->m_backBuffer.size() * sizeof(u16);
+                return this->getFramebufferSize();
+            }
+            
             /**
              * @brief Get the number of framebuffers in use
              *
              * @return Number of framebuffers
              */
             inline size_t getFramebufferCount() {
+                if (this->m_headless)
+                    return this->m_headlessFramebuffer.count();
                 return this->m_framebuffer.num_fbs;
             }
             
@@ -2952,6 +5776,8 @@ namespace tsl {
              * @return Slot
              */
             inline u8 getCurrentFramebufferSlot() {
+                if (this->m_headless)
+                    return this->m_headlessFramebuffer.currentSlot();
                 return this->m_window.cur_slot;
             }
             
@@ -2969,6 +5795,9 @@ namespace tsl {
              *
              */
             inline void waitForVSync() {
+                TSL_PROFILE_PHASE(VSync);
+                if (this->m_headless)
+                    return;
                 eventWait(&this->m_vsyncEvent, UINT64_MAX);
             }
             
@@ -2981,6 +5810,16 @@ namespace tsl {
              */
 
             inline u32 getPixelOffset(const u32 x, const u32 y) {
+                // Display list replay clips to the recorded scissor within the current band
+                if (s_replayClip) [[unlikely]] {
+                    const ClipRect& clip = *s_replayClip;
+                    if (static_cast<s32>(x) < clip.x0 || static_cast<s32>(y) < clip.y0 ||
+                        static_cast<s32>(x) >= clip.x1 || static_cast<s32>(y) >= clip.y1) {
+                        return UINT32_MAX;
+                    }
+                    return this->getTargetOffset(x, y);
+                }
+                
                 // Check for scissoring boundaries
                 if (!this->m_scissoringStack.empty()) {
                     const auto& currScissorConfig = this->m_scissoringStack.top();
@@ -3016,9 +5855,7 @@ namespace tsl {
                 //       ((y & 1) << 3) +             // (y % 2) * 8
                 //       (x & 7);                     // x % 8
 
-                return ((((y & 127) >> 4) + ((x >> 5) << 3) + ((y >> 7) * offsetWidthVar)) << 9) +
-                       ((y & 8) << 5) + ((x & 16) << 3) + ((y & 6) << 4) + 
-                       ((x & 8) << 1) + ((y & 1) << 3) + (x & 7);
+                return this->getTargetOffset(x, y);
 
                 //const u32 y_hi = y >> 7;
                 //const u32 y_mid = (y >> 4) & 7;    // bits 4-6 of y
@@ -3032,6 +5869,100 @@ namespace tsl {
                 //       (((y_lo & 7) >> 1) << 5) + (((x_lo & 15) >> 3) << 4) +
                 //       ((y_lo & 1) << 3) + (x_lo & 7);
             }
+            
+            /**
+             * @brief Swizzled framebuffer offset without scissor checks, for callers that clip up front
+             *
+             * @param x X pos
+             * @param y Y Pos
+             * @return Offset
+             */
+            inline u32 getSwizzledOffset(const u32 x, const u32 y) const {
+                return computeRowOffset(y) + getColumnOffset(x);
+            }
+            
+            /**
+             * @brief Row part of the swizzled offset, independent of x
+             *
+             * @param y Y pos
+             * @return Offset of pixel (0, y)
+             */
+            static inline u32 computeRowOffset(const u32 y) {
+                return ((((y & 127) >> 4) + ((y >> 7) * offsetWidthVar)) << 9) +
+                       ((y & 8) << 5) + ((y & 6) << 4) + ((y & 1) << 3);
+            }
+            
+            /**
+             * @brief Column part of the swizzled offset, independent of y
+             *
+             * @param x X pos
+             * @return Offset of pixel (x, 0)
+             */
+            static inline u32 getColumnOffset(const u32 x) {
+                return ((x >> 5) << 12) + ((x & 16) << 3) + ((x & 8) << 1) + (x & 7);
+            }
+            
+            /**
+             * @brief Row base offset into the draw target from the precomputed table, falling back to the formula before init
+             *
+             * @param y Y pos
+             * @return Offset of pixel (0, y)
+             */
+            inline u32 getRowOffset(const u32 y) const {
+                if (y < this->m_rowOffsets.size())
+                    return this->m_rowOffsets[y];
+                return this->m_linearTarget ? y * this->m_backBufferStride : computeRowOffset(y);
+            }
+            
+            /**
+             * @brief Column part of the offset into the draw target
+             *
+             * @param x X pos
+             * @return Offset of pixel (x, 0)
+             */
+            inline u32 getTargetColumnOffset(const u32 x) const {
+                return this->m_linearTarget ? x : getColumnOffset(x);
+            }
+            
+            /**
+             * @brief Offset into the draw target (swizzled framebuffer or linear back buffer) without scissor checks
+             *
+             * @param x X pos
+             * @param y Y Pos
+             * @return Offset
+             */
+            inline u32 getTargetOffset(const u32 x, const u32 y) const {
+                return this->getRowOffset(y) + this->getTargetColumnOffset(x);
+            }
+            
+            /**
+             * @brief Rebuilds the row base table, must run whenever the framebuffer size or the draw target changes
+             */
+            inline void updateSwizzleTables() {
+                this->m_rowOffsets.resize(cfg::FramebufferHeight);
+                for (u32 y = 0; y < this->m_rowOffsets.size(); ++y)
+                    this->m_rowOffsets[y] = this->m_linearTarget ? y * this->m_backBufferStride : computeRowOffset(y);
+            }
+            
+            /**
+             * @brief Gets the drawable area (framebuffer intersected with the active scissor) as a half-open rect
+             */
+            inline ClipRect getClipRect() const {
+                if (s_replayClip) [[unlikely]]
+                    return *s_replayClip;
+                
+                ClipRect clip = { 0, 0, cfg::FramebufferWidth, cfg::FramebufferHeight };
+                
+                if (!this->m_scissoringStack.empty()) {
+                    const auto& currScissorConfig = this->m_scissoringStack.top();
+                    clip.x0 = std::max(clip.x0, static_cast<s32>(currScissorConfig.x));
+                    clip.y0 = std::max(clip.y0, static_cast<s32>(currScissorConfig.y));
+                    clip.x1 = std::min(clip.x1, static_cast<s32>(currScissorConfig.x + currScissorConfig.w));
+                    clip.y1 = std::min(clip.y1, static_cast<s32>(currScissorConfig.y + currScissorConfig.h));
+                }
+                
+                return clip;
+            }
 
             
             /**
@@ -3051,6 +5982,7 @@ namespace tsl {
                 cfg::FramebufferHeight = ult::DefaultFramebufferHeight;
 
                 offsetWidthVar = (((cfg::FramebufferWidth / 2) >> 4) << 3);
+                this->updateSwizzleTables();
 
                 ult::correctFrameSize = (cfg::FramebufferWidth == 448 && cfg::FramebufferHeight == 720); // for detecting the correct Overlay display size
                 if (ult::useRightAlignment && ult::correctFrameSize) {
@@ -3115,26 +6047,508 @@ namespace tsl {
                     setExit();
                 });
                 
-                this->m_initialized = true;
+                // Restore glyphs from the last run, then warm whatever is still missing while the first Gui is being built
+                FontManager::loadPersistentCache();
+                FontManager::preloadStandardGlyphsAsync();
+                
+                this->m_workerPool.start(ult::numThreads);
+                this->m_initialized = true;
+            }
+            
+        public:
+            /**
+             * @brief Initializes the renderer on in-memory framebuffers instead of a VI layer
+             * @note Fonts are not loaded from the system; initialize FontManager with the fonts to test against.
+             *
+             * @param width Framebuffer width
+             * @param height Framebuffer height
+             */
+            void initHeadless(u16 width = 448, u16 height = 720) {
+                if (this->m_initialized)
+                    return;
+                
+                cfg::FramebufferWidth  = width;
+                cfg::FramebufferHeight = height;
+                offsetWidthVar = (((cfg::FramebufferWidth / 2) >> 4) << 3);
+                this->updateSwizzleTables();
+                
+                this->m_headlessFramebuffer.create(width, height, 2);
+                this->m_workerPool.start(ult::numThreads);
+                this->m_headless = true;
+                this->m_initialized = true;
+            }
+            
+            /**
+             * @brief Whether the renderer runs headless
+             */
+            inline bool isHeadless() const {
+                return this->m_headless;
+            }
+            
+            /**
+             * @brief Writes the last presented headless frame as a PPM image
+             *
+             * @param path Output path
+             * @return true on success, false if not headless or the write failed
+             */
+            bool dumpFrame(const std::string& path) {
+                if (!this->m_headless)
+                    return false;
+                return this->m_headlessFramebuffer.writePPM(path, this->m_headlessFramebuffer.lastPresentedSlot());
+            }
+            
+            /**
+             * @brief Starts a headless frame (frames on hardware are driven by the Overlay)
+             */
+            inline void beginHeadlessFrame() {
+                if (this->m_headless)
+                    this->startFrame();
+            }
+            
+            /**
+             * @brief Presents the current headless frame
+             */
+            inline void endHeadlessFrame() {
+                if (this->m_headless && this->m_currentFramebuffer)
+                    this->endFrame();
+            }
+            
+            /**
+             * @brief Releases the headless framebuffers
+             */
+            inline void exitHeadless() {
+                if (this->m_headless)
+                    this->exit();
+            }
+            
+            /**
+             * @brief Enables recording frames into a display list that is rasterized in row bands across the
+             *        render worker pool when the frame ends
+             * @note Takes effect from the next frame and only while the pool has workers. Pointer arguments of
+             *       drawBitmapRGBA4444 must stay valid until the frame ends; drawBitmap sources are copied.
+             *
+             * @param enabled Enabled
+             */
+            inline static void setDisplayListEnabled(bool enabled) {
+                s_displayListEnabled = enabled;
+            }
+            
+            /**
+             * @brief Whether display list recording is enabled
+             */
+            inline static bool isDisplayListEnabled() {
+                return s_displayListEnabled;
+            }
+            
+            /**
+             * @brief Enables partial redraw: frames are recorded and only bands whose draw commands changed since the
+             *        framebuffer being drawn last held them are rasterized
+             * @note Damage is found by comparing command hashes per band of DisplayListBandHeight rows, so elements
+             *       don't have to report it; the wallpaper and background commands in a damaged band are replayed
+             *       as well. Frames must fully repaint what they show (as OverlayFrame does) and draw only through
+             *       the Renderer primitives. Use addDamage() for changes the commands can't see.
+             *
+             * @param enabled Enabled
+             */
+            inline static void setPartialRedrawEnabled(bool enabled) {
+                s_partialRedrawEnabled = enabled;
+            }
+            
+            /**
+             * @brief Whether partial redraw is enabled
+             */
+            inline static bool isPartialRedrawEnabled() {
+                return s_partialRedrawEnabled;
+            }
+            
+            /**
+             * @brief Draws into a linear RGBA4444 back buffer that endFrame() swizzles into the framebuffer
+             * @note Primitives then get whole row spans instead of 8 pixel groups. Every write into the back buffer
+             *       marks the GOBs (32x8 pixels) it touches, and the present only copies the GOBs written since the
+             *       framebuffer about to be shown last received the frame. The back buffer keeps its contents, so
+             *       it is the one target partial redraw tracks: together with \ref setPartialRedrawEnabled only the
+             *       changed bands are drawn and presented. Costs one framebuffer worth of memory.
+             *
+             * @param enabled Enabled, takes effect on the next frame
+             */
+            inline static void setLinearBackBufferEnabled(bool enabled) {
+                s_linearBackBufferEnabled = enabled;
+            }
+            
+            /**
+             * @brief Whether the linear back buffer is enabled
+             */
+            inline static bool isLinearBackBufferEnabled() {
+                return s_linearBackBufferEnabled;
+            }
+            
+            /**
+             * @brief Number of GOBs the last present copied to the framebuffer
+             */
+            inline u32 getLastPresentTileCount() const {
+                return this->m_lastPresentTileCount;
+            }
+            
+            /**
+             * @brief Forces the bands overlapping a rectangle to be redrawn in every framebuffer
+             *
+             * @param x X pos
+             * @param y Y pos
+             * @param w Width
+             * @param h Height
+             */
+            inline void addDamage(s32 x, s32 y, s32 w, s32 h) {
+                if (this->m_slotBandSignatures.empty() || w <= 0 || h <= 0)
+                    return;
+                
+                const s32 bandCount = static_cast<s32>(this->m_slotBandSignatures.size() / this->getSignatureSlotCount());
+                const s32 firstBand = std::max(y, 0) / DisplayListBandHeight;
+                const s32 lastBand = std::min((y + h + DisplayListBandHeight - 1) / DisplayListBandHeight, bandCount);
+                
+                for (size_t slot = 0; slot < this->getSignatureSlotCount(); ++slot) {
+                    for (s32 band = firstBand; band < lastBand; ++band)
+                        this->m_slotBandSignatures[slot * bandCount + band] = 0;
+                }
+            }
+            
+            /**
+             * @brief Forces the next frames to be redrawn completely
+             */
+            inline void invalidate() {
+                this->m_slotBandSignatures.clear();
+                std::fill(this->m_slotDamage.begin(), this->m_slotDamage.end(), UINT32_MAX);
+            }
+            
+            /**
+             * @brief Number of bands rasterized by the last frame, 0 when nothing changed
+             */
+            inline u32 getLastRedrawBandCount() const {
+                return this->m_lastRedrawBandCount;
+            }
+            
+        private:
+            
+            /**
+             * @brief Exits the renderer and layer
+             *
+             */
+            void exit() {
+                if (!this->m_initialized)
+                    return;
+                
+                this->m_workerPool.stop();
+                this->invalidate();
+                this->releaseBackgroundLayer();
+                this->setLinearTarget(false);
+                
+                if (this->m_headless) {
+                    this->m_headlessFramebuffer.close();
+                    this->m_headless = false;
+                    this->m_initialized = false;
+                    return;
+                }
+                
+                // Persist newly rasterized glyphs, then cleanup shared font manager
+                FontManager::stopPreload();
+                FontManager::savePersistentCache();
+                FontManager::cleanup();
+
+                framebufferClose(&this->m_framebuffer);
+                nwindowClose(&this->m_window);
+                viDestroyManagedLayer(&this->m_layer);
+                viCloseDisplay(&this->m_display);
+                eventClose(&this->m_vsyncEvent);
+                viExit();
+            }
+            
+            /**
+             * @brief Records a draw into the display list with the clip active right now
+             *
+             * @param y0 First row the draw may touch
+             * @param y1 One past the last row
+             * @param hash DisplayList::hash() of the draw and its arguments
+             * @param fn Callable (Renderer&) that issues the draw again at replay
+             */
+            template<typename Fn>
+            inline void record(const s32 y0, const s32 y1, const u64 hash, Fn&& fn) {
+                const ClipRect clip = this->getClipRect();
+                if (std::max(y0, clip.y0) >= std::min(y1, clip.y1) || clip.x0 >= clip.x1)
+                    return;
+                
+                this->m_displayList.record(y0, y1, clip, hash, std::forward<Fn>(fn));
+            }
+            
+            /**
+             * @brief Remembers the background of the current frame together with the state every draw depends on
+             */
+            inline void setFrameBackground(const u64 key, const bool fromLayer) {
+                const bool forceOpaque = ult::disableTransparency && ult::useOpaqueScreenshots;
+                this->m_frameBackgroundKey = DisplayList::combine(key, DisplayList::hash("frame", Renderer::s_opacity, forceOpaque,
+                                                                                         FontManager::getGeneration())) | 1;
+                this->m_frameBackgroundFromLayer = fromLayer;
+            }
+            
+            /**
+             * @brief Switches the draw target between the framebuffer slots and the linear back buffer
+             * @note Everything laid out for the previous target (row table, band signatures, background layer) is rebuilt.
+             */
+            void setLinearTarget(const bool linear) {
+                if (linear == this->m_linearTarget)
+                    return;
+                
+                this->m_linearTarget = linear;
+                if (linear) {
+                    this->m_backBufferStride = (cfg::FramebufferWidth + 31) & ~31u;
+                    const size_t pixels = static_cast<size_t>(this->m_backBufferStride) * ((cfg::FramebufferHeight + 7) & ~7u);
+                    this->m_backBuffer.assign(std::max(pixels, this->getFramebufferSize() / sizeof(u16)), 0);
+                    
+                    // Nothing is known about the slots yet, the first present of each copies everything
+                    const size_t gobRows = (cfg::FramebufferHeight + 7) / 8;
+                    this->m_frameDamage.assign(gobRows, 0);
+                    this->m_slotDamage.assign(gobRows * this->getFramebufferCount(), UINT32_MAX);
+                } else {
+                    this->m_backBuffer.clear();
+                    this->m_backBuffer.shrink_to_fit();
+                    this->m_backBufferStride = 0;
+                    this->m_presentFramebuffer = nullptr;
+                    this->m_frameDamage.clear();
+                    this->m_slotDamage.clear();
+                }
+                
+                this->updateSwizzleTables();
+                this->invalidate();
+                this->m_backgroundKey = 0;
+            }
+            
+            /**
+             * @brief Marks the GOBs overlapping a rectangle of the linear back buffer as written
+             * @note The rectangle must already be clipped to the framebuffer and not be empty.
+             *
+             * @param x0 First x
+             * @param x1 One past the last x
+             * @param y0 First y
+             * @param y1 One past the last y
+             */
+            inline void markWritten(const s32 x0, const s32 x1, const s32 y0, const s32 y1) {
+                const u32 columns = ((2u << ((x1 - 1) >> 5)) - 1) & ~((1u << (x0 >> 5)) - 1);
+                u32* const damage = this->m_frameDamage.data();
+                for (s32 gobRow = y0 >> 3; gobRow <= (y1 - 1) >> 3; ++gobRow)
+                    damage[gobRow] |= columns;
+            }
+            
+            /**
+             * @brief Swizzles the damaged part of the linear back buffer into the framebuffer being presented
+             * @note This frame's damage is added to what every slot still misses, then the GOBs (32x8 pixels, 512
+             *       contiguous bytes) the presented slot misses are copied in their memory order and its damage is
+             *       cleared. GOB rows are spread over the workers.
+             */
+            void presentBackBuffer() {
+                const u16* const back = this->m_backBuffer.data();
+                u16* const target = static_cast<u16*>(this->m_presentFramebuffer);
+                const u32 stride = this->m_backBufferStride;
+                const s32 gobRows = static_cast<s32>(this->m_frameDamage.size());
+                
+                for (size_t i = 0; i < this->m_slotDamage.size(); ++i)
+                    this->m_slotDamage[i] |= this->m_frameDamage[i % gobRows];
+                std::fill(this->m_frameDamage.begin(), this->m_frameDamage.end(), 0);
+                
+                u32* const damage = this->m_slotDamage.data() + this->getCurrentFramebufferSlot() * gobRows;
+                const u32 gobColumns = cfg::FramebufferWidth / 32;
+                const u32 columnMask = gobColumns < 32 ? (1u << gobColumns) - 1 : UINT32_MAX;
+                std::atomic<u32> copiedTiles{ 0 };
+                
+                const s32 chunkSize = std::max((s32)1, (s32)(gobRows / (this->m_workerPool.size() * 2)));
+                this->m_workerPool.parallelFor(0, gobRows, chunkSize, [&](s32 firstRow, s32 lastRow) {
+                    u32 copied = 0;
+                    for (s32 gobRow = firstRow; gobRow < lastRow; ++gobRow) {
+                        u32 columns = damage[gobRow] & columnMask;
+                        damage[gobRow] = 0;
+                        
+                        const u32 y0 = static_cast<u32>(gobRow) * 8;
+                        const u32 rowOffset = computeRowOffset(y0);
+                        for (; columns != 0; columns &= columns - 1) {
+                            const u32 column = __builtin_ctz(columns);
+                            u16* dst = target + rowOffset + getColumnOffset(column * 32);
+                            const u16* const src = back + y0 * stride + column * 32;
+                            
+                            // Run c of the GOB holds row ((c >> 2) & 3) * 2 + (c & 1), pixels 8 * (((c >> 4) & 1) * 2 + ((c >> 1) & 1)) onwards
+                            for (u32 run = 0; run < 32; ++run, dst += 8) {
+                                std::memcpy(dst, src + ((((run >> 2) & 3) << 1) + (run & 1)) * stride +
+                                                 ((((run >> 4) & 1) << 1) + ((run >> 1) & 1)) * 8, 8 * sizeof(u16));
+                            }
+                            ++copied;
+                        }
+                    }
+                    copiedTiles.fetch_add(copied, std::memory_order_relaxed);
+                });
+                
+                this->m_lastPresentTileCount = copiedTiles.load(std::memory_order_relaxed);
+            }
+            
+            /**
+             * @brief Composites the background layer with the regular primitives, drawing into the layer buffer
+             */
+            void rebuildBackgroundLayer(const Color& fillColor, std::initializer_list<StaticRect> chrome, const bool withWallpaper) {
+                this->m_backgroundLayer.resize(this->getTargetSize() / sizeof(u16));
+                
+                void* const framebuffer = this->m_currentFramebuffer;
+                const bool recording = this->m_recording;
+                std::stack<ScissoringConfig> scissoringStack;
+                std::swap(scissoringStack, this->m_scissoringStack);
+                
+                this->m_currentFramebuffer = this->m_backgroundLayer.data();
+                this->m_recording = false;
+                
+                this->fillScreen(fillColor);
+                if (withWallpaper)
+                    this->drawBitmapRGBA4444(0, 0, cfg::FramebufferWidth, cfg::FramebufferHeight, ult::wallpaperData.data());
+                for (const auto& rect : chrome)
+                    this->drawRect(rect.x, rect.y, rect.w, rect.h, rect.color);
+                
+                std::swap(scissoringStack, this->m_scissoringStack);
+                this->m_recording = recording;
+                this->m_currentFramebuffer = framebuffer;
+            }
+            
+            /**
+             * @brief Copies the background layer into the current framebuffer (the band only, during replay)
+             */
+            void blitBackgroundLayer() {
+                u16* const framebuffer = static_cast<u16*>(this->getCurrentFramebuffer());
+                const u16* const layer = this->m_backgroundLayer.data();
+                
+                if (!s_replayClip) {
+                    std::memcpy(framebuffer, layer, std::min(this->m_backgroundLayer.size() * sizeof(u16), this->getTargetSize()));
+                    if (this->m_linearTarget)
+                        this->markWritten(0, cfg::FramebufferWidth, 0, cfg::FramebufferHeight);
+                    return;
+                }
+                
+                const ClipRect clip = *s_replayClip;
+                for (s32 y = clip.y0; y < clip.y1; ++y) {
+                    this->forEachRowRun(clip, clip.x0, clip.x1, y, [framebuffer, layer](u16* dst, s32, s32 runLength) {
+                        std::memcpy(dst, layer + (dst - framebuffer), runLength * sizeof(u16));
+                    });
+                }
+            }
+            
+            /**
+             * @brief Rasterizes the recorded frame
+             * @note The framebuffer is split into bands of DisplayListBandHeight rows that the worker pool
+             *       takes one at a time. Every band replays the commands overlapping it in recording order,
+             *       clipped to the band, so no two threads ever write the same pixel.
+             */
+            void flushDisplayList() {
+                if (!this->m_recording)
+                    return;
+                this->m_recording = false;
+                
+                const auto& commands = this->m_displayList.commands();
+                const s32 bandCount = (cfg::FramebufferHeight + DisplayListBandHeight - 1) / DisplayListBandHeight;
+                
+                this->m_redrawBands.clear();
+                if (s_partialRedrawEnabled) {
+                    this->collectDamagedBands(commands, bandCount);
+                } else {
+                    for (s32 band = 0; band < bandCount; ++band)
+                        this->m_redrawBands.push_back(band);
+                }
+                this->m_lastRedrawBandCount = static_cast<u32>(this->m_redrawBands.size());
+                
+                if (!commands.empty() && !this->m_redrawBands.empty()) {
+                    const s32* const bands = this->m_redrawBands.data();
+                    this->m_workerPool.parallelFor(0, static_cast<s32>(this->m_redrawBands.size()), 1, [this, &commands, bands](s32 first, s32 last) {
+                        ClipRect clip;
+                        s32 bandY0, bandY1;
+                        
+                        for (s32 i = first; i < last; ++i) {
+                            bandY0 = bands[i] * DisplayListBandHeight;
+                            bandY1 = std::min<s32>(bandY0 + DisplayListBandHeight, cfg::FramebufferHeight);
+                            
+                            for (const auto& command : commands) {
+                                clip = {
+                                    command.clip.x0, std::max({ command.clip.y0, command.y0, bandY0 }),
+                                    command.clip.x1, std::min({ command.clip.y1, command.y1, bandY1 })
+                                };
+                                if (clip.y0 >= clip.y1)
+                                    continue;
+                                
+                                s_replayClip = &clip;
+                                command.invoke(command.payload, *this);
+                            }
+                        }
+                        s_replayClip = nullptr;
+                    });
+                }
+                
+                this->m_displayList.clear();
+                FontManager::unpinGlyphs(this->m_pinnedGlyphs);
+                
+                if (this->m_releasePlotOnFlush) {
+                    this->m_releasePlotOnFlush = false;
+                    ult::inPlot.store(false, std::memory_order_release);
+                }
             }
             
             /**
-             * @brief Exits the renderer and layer
-             *
+             * @brief Fills m_redrawBands with the bands whose commands differ from what the draw target holds
+             * @note A band's signature chains the hashes of every command overlapping it in recording order, seeded
+             *       with the state replay reads implicitly (opacity, font generation). Matching signatures mean the
+             *       slot already contains exactly what replaying the band would produce.
              */
-            void exit() {
-                if (!this->m_initialized)
+            void collectDamagedBands(const std::vector<DisplayList::Command>& commands, const s32 bandCount) {
+                const size_t slotCount = this->getSignatureSlotCount();
+                if (this->m_slotBandSignatures.size() != slotCount * bandCount)
+                    this->m_slotBandSignatures.assign(slotCount * bandCount, 0);
+                
+                const u64 seed = DisplayList::hash("frame", Renderer::s_opacity, FontManager::getGeneration(),
+                                                   cfg::FramebufferWidth, cfg::FramebufferHeight);
+                this->m_bandSignatures.assign(bandCount, seed);
+                
+                s32 firstBand, lastBand;
+                for (const auto& command : commands) {
+                    firstBand = std::max({ command.y0, command.clip.y0, 0 }) / DisplayListBandHeight;
+                    lastBand = std::min<s32>(std::min(command.y1, command.clip.y1), cfg::FramebufferHeight);
+                    lastBand = (lastBand + DisplayListBandHeight - 1) / DisplayListBandHeight;
+                    for (s32 band = firstBand; band < lastBand; ++band)
+                        this->m_bandSignatures[band] = DisplayList::combine(this->m_bandSignatures[band], command.hash);
+                }
+                
+                u64* const slotSignatures = this->m_slotBandSignatures.data() + this->getSignatureSlot() * bandCount;
+                for (s32 band = 0; band < bandCount; ++band) {
+                    // 0 marks an unknown band, keep real signatures away from it
+                    const u64 signature = this->m_bandSignatures[band] | 1;
+                    if (slotSignatures[band] != signature) {
+                        slotSignatures[band] = signature;
+                        this->m_redrawBands.push_back(band);
+                    }
+                }
+            }
+            
+            /**
+             * @brief Number of draw targets whose band signatures are tracked, the linear back buffer is the only one
+             */
+            inline size_t getSignatureSlotCount() {
+                return this->m_linearTarget ? 1 : this->getFramebufferCount();
+            }
+            
+            /**
+             * @brief Band signature slot of the current draw target
+             */
+            inline size_t getSignatureSlot() {
+                return this->m_linearTarget ? 0 : this->getCurrentFramebufferSlot();
+            }
+            
+            /**
+             * @brief Carries band signatures over when a slot's pixels are copied into another slot
+             */
+            void copyBandSignatures(const u8 fromSlot, const u8 toSlot) {
+                if (this->m_slotBandSignatures.empty())
                     return;
                 
-                // Cleanup shared font manager
-                FontManager::cleanup();
-
-                framebufferClose(&this->m_framebuffer);
-                nwindowClose(&this->m_window);
-                viDestroyManagedLayer(&this->m_layer);
-                viCloseDisplay(&this->m_display);
-                eventClose(&this->m_vsyncEvent);
-                viExit();
+                const size_t bandCount = this->m_slotBandSignatures.size() / this->getSignatureSlotCount();
+                std::copy_n(this->m_slotBandSignatures.begin() + fromSlot * bandCount, bandCount,
+                            this->m_slotBandSignatures.begin() + toSlot * bandCount);
             }
             
             /**
@@ -3198,7 +6612,29 @@ namespace tsl {
              * @warning Don't call this more than once before calling \ref endFrame
              */
             inline void startFrame() {
-                this->m_currentFramebuffer = framebufferBegin(&this->m_framebuffer, nullptr);
+                TSL_PROFILE_PHASE(StartFrame);
+                
+                // Recording pays off when there are workers to rasterize on, or unchanged bands to skip
+                this->m_recording = s_partialRedrawEnabled || (s_displayListEnabled && this->m_workerPool.size() > 1);
+                
+                // Immediate frames overwrite whatever the slots held, so nothing is known about them anymore
+                if (!s_partialRedrawEnabled)
+                    this->invalidate();
+                this->m_frameBackgroundKey = 0;
+                this->m_lastRedrawBandCount = (cfg::FramebufferHeight + DisplayListBandHeight - 1) / DisplayListBandHeight;
+                
+                this->setLinearTarget(s_linearBackBufferEnabled);
+                
+                if (this->m_headless)
+                    this->m_currentFramebuffer = this->m_headlessFramebuffer.begin();
+                else
+                    this->m_currentFramebuffer = framebufferBegin(&this->m_framebuffer, nullptr);
+                
+                // Primitives draw into the back buffer, the slot only receives the present
+                if (this->m_linearTarget) {
+                    this->m_presentFramebuffer = this->m_currentFramebuffer;
+                    this->m_currentFramebuffer = this->m_backBuffer.data();
+                }
             }
             
             /**
@@ -3206,17 +6642,38 @@ namespace tsl {
              * @warning Don't call this before calling \ref startFrame once
              */
             inline void endFrame() {
+                TSL_PROFILE_PHASE(EndFrame);
+                
+                {
+                    TSL_PROFILE_PHASE(Flush);
+                    this->flushDisplayList();
+                }
+                
+                if (this->m_linearTarget) {
+                    TSL_PROFILE_PHASE(Present);
+                    this->presentBackBuffer();
+                }
+                
                 #if IS_STATUS_MONITOR_DIRECTIVE
                 if (!FullMode || deactivateOriginalFooter) {
-                    __builtin_memcpy(this->getNextFramebuffer(), this->getCurrentFramebuffer(), this->getFramebufferSize());
+                    // The back buffer already carries the frame over, and the next present brings the slot up to date
+                    if (!this->m_linearTarget) {
+                        __builtin_memcpy(this->getNextFramebuffer(), this->getCurrentFramebuffer(), this->getFramebufferSize());
+                        this->copyBandSignatures(this->getCurrentFramebufferSlot(), this->getNextFramebufferSlot());
+                    }
                     svcSleepThread(1000*1000*1000 / TeslaFPS);
                 }
                 #endif
 
                 this->waitForVSync();
-                framebufferEnd(&this->m_framebuffer);
+                this->m_lastPresentedSlot = this->getCurrentFramebufferSlot();
+                if (this->m_headless)
+                    this->m_headlessFramebuffer.end();
+                else
+                    framebufferEnd(&this->m_framebuffer);
                 
                 this->m_currentFramebuffer = nullptr;
+                ++this->m_frameNumber;
             }
 
         #if IS_STATUS_MONITOR_DIRECTIVE
@@ -3254,6 +6711,23 @@ namespace tsl {
                 if (glyphBmp == nullptr)
                     return;
                 
+                if (this->m_recording) [[unlikely]] {
+                    // The glyph cache isn't thread-safe, so the bitmap is resolved here and copied into the list
+                    const u8* pixels = this->m_displayList.copy(glyphBmp, static_cast<size_t>(width) * height);
+                    if (!fontCache) std::free(glyphBmp);
+                    this->record(y, y + height, DisplayList::hash("drawGlyph", codepoint, static_cast<const void*>(font), fontSize, x, y, color),
+                        [=](Renderer& renderer) { renderer.blitGlyphBitmap(pixels, x, y, width, height, color); });
+                    return;
+                }
+                
+                this->blitGlyphBitmap(glyphBmp, x, y, width, height, color);
+                if (!fontCache) std::free(glyphBmp);
+            }
+            
+            /**
+             * @brief Blends an 8-bit glyph coverage bitmap as drawGlyph does
+             */
+            inline void blitGlyphBitmap(const u8* glyphBmp, s32 x, s32 y, int width, int height, Color color) {
                 // Pre-calculate constants outside loops
                 const float colorAFloat = float(color.a) / 15.0f;  // Divide by 15, not 0xF
                 const u8* bmpPtr = glyphBmp;  // Cache pointer for faster access
@@ -3271,10 +6745,38 @@ namespace tsl {
                         }
                     }
                 }
-                if (!fontCache) std::free(glyphBmp);
             }
         #endif
         };
+        
+        // Defined here so the pixels are read through the renderer's own swizzle helpers
+        inline bool HeadlessFramebuffer::writePPM(const std::string& path, u32 slot, Color background) {
+            if (m_buffer.empty() || slot >= m_count)
+                return false;
+            
+            const u16* buffer = static_cast<const u16*>(slotData(slot));
+            std::vector<u8> image;
+            image.reserve(static_cast<size_t>(m_width) * m_height * 3);
+            
+            for (u32 y = 0; y < m_height; ++y) {
+                const u32 rowOffset = Renderer::computeRowOffset(y);
+                for (u32 x = 0; x < m_width; ++x) {
+                    const Color pixel(buffer[rowOffset + Renderer::getColumnOffset(x)]);
+                    image.push_back(compositeChannel(pixel.r, background.r, pixel.a));
+                    image.push_back(compositeChannel(pixel.g, background.g, pixel.a));
+                    image.push_back(compositeChannel(pixel.b, background.b, pixel.a));
+                }
+            }
+            
+            FILE* file = fopen(path.c_str(), "wb");
+            if (!file)
+                return false;
+            
+            fprintf(file, "P6\n%u %u\n255\n", m_width, m_height);
+            const bool written = fwrite(image.data(), 1, image.size(), file) == image.size();
+            fclose(file);
+            return written;
+        }
 
         static std::pair<int, int> getUnderscanPixels() {
             if (!ult::consoleIsDocked()) {
@@ -3314,6 +6816,40 @@ namespace tsl {
     }
     
     
+    #if FRAME_PROFILER_DIRECTIVE
+    namespace profiler {
+        
+        /**
+         * @brief Draws the timing HUD in the top left corner (p50/p95/p99 per phase, in milliseconds)
+         * @note Its text is timed like any other, so it shows up in the text and draw phases.
+         */
+        inline void drawHud(gfx::Renderer* renderer) {
+            static constexpr s32 LineHeight = 16;
+            static constexpr s32 Columns[] = { 10, 96, 146, 196 };
+            static constexpr const char* Headers[] = { "ms", "p50", "p95", "p99" };
+            
+            renderer->drawRect(4, 4, 240, LineHeight * (PhaseCount + 1) + 8, gfx::Renderer::a({0x0, 0x0, 0x0, 0xC}));
+            
+            for (u32 column = 0; column < 4; ++column)
+                renderer->drawString(Headers[column], false, Columns[column], 4 + LineHeight, 13, gfx::Renderer::a({0xF, 0xF, 0x0, 0xF}));
+            
+            char value[16];
+            for (u32 i = 0; i < PhaseCount; ++i) {
+                const s32 y = 4 + LineHeight * (i + 2);
+                const PhaseStats stats = getStats(static_cast<Phase>(i));
+                const u32 percentiles[] = { stats.p50, stats.p95, stats.p99 };
+                
+                renderer->drawString(PhaseNames[i], false, Columns[0], y, 13, gfx::Renderer::a({0xF, 0xF, 0xF, 0xF}));
+                for (u32 column = 0; column < 3; ++column) {
+                    snprintf(value, sizeof(value), "%.2f", percentiles[column] / 1000.0f);
+                    renderer->drawString(value, false, Columns[column + 1], y, 13, gfx::Renderer::a({0xF, 0xF, 0xF, 0xF}));
+                }
+            }
+        }
+    }
+    #endif
+    
+    
     // Elements
     
     namespace elm {
@@ -3437,6 +6973,8 @@ namespace tsl {
             void inline frame(gfx::Renderer *renderer) {
                 
                 if (this->m_focused) {
+                    // The highlight pulses continuously, keep it smooth while the loop idles
+                    governor::requestAnimationInterval();
                     renderer->enableScissoring(0, ult::activeHeaderHeight, tsl::cfg::FramebufferWidth, tsl::cfg::FramebufferHeight-73-ult::activeHeaderHeight);
                     this->drawFocusBackground(renderer);
                     this->drawHighlight(renderer);
@@ -3579,6 +7117,7 @@ namespace tsl {
             virtual void drawFocusBackground(gfx::Renderer *renderer) {
                 if (this->m_clickAnimationProgress > 0) {
                     this->drawClickAnimation(renderer);
+                    governor::requestFrames();
             
                     // Single time calculation and direct millisecond conversion
                     double elapsed_ms = (armTicksToNs(armGetSystemTick()) - this->m_animationStartTime) * 0.000001; // Direct conversion
@@ -3789,6 +7328,25 @@ namespace tsl {
                 this->m_focused = focused;
                 this->m_clickAnimationProgress = 0;
             }
+            
+            /**
+             * @brief Whether this element currently draws the highlight
+             */
+            inline bool hasFocus() const {
+                return this->m_focused;
+            }
+
+            /**
+             * @brief Identifies everything the unfocused element draws, apart from its position
+             * @note List scroll blitting only reuses the previous frame's pixels of an element whose signature is
+             *       unchanged. Return 0 when the element can't tell, e.g. because it animates; it's then drawn again
+             *       every frame. Elements overriding draw() have to override this as well.
+             *
+             * @return Signature, 0 when unknown
+             */
+            virtual u64 getDrawSignature() {
+                return 0;
+            }
 
             virtual bool matchesJumpCriteria(const std::string& jumpText, const std::string& jumpValue, bool contains) const {
                 return false; // Default implementation for non-ListItem elements
@@ -3993,8 +7551,9 @@ namespace tsl {
                 
                 
                 if (FullMode == true) {
-                    renderer->fillScreen(a(defaultBackgroundColor));
-                    renderer->drawWallpaper();
+                    renderer->drawStaticBackground(a(defaultBackgroundColor), {
+                        {15, tsl::cfg::FramebufferHeight - 73, tsl::cfg::FramebufferWidth - 30, 1, a(botttomSeparatorColor)}
+                    });
                 } else {
                     renderer->fillScreen({ 0x0, 0x0, 0x0, alphabackground});
                 }
@@ -4005,9 +7564,6 @@ namespace tsl {
                 renderer->drawString(this->m_title, false, 20, 50+2, 32, a(defaultOverlayColor));
                 renderer->drawString(this->m_subtitle, false, 20, y+23, 15, a(versionTextColor));
                 
-                if (FullMode == true)
-                    renderer->drawRect(15, tsl::cfg::FramebufferHeight - 73, tsl::cfg::FramebufferWidth - 30, 1, a(botttomSeparatorColor));
-                
                 if (FullMode && !deactivateOriginalFooter) {
                     // Use getTextDimensions instead of calculateStringWidth
                     auto [backWidth, backHeight] = renderer->getTextDimensions(ult::BACK, false, 23);
@@ -4194,8 +7750,9 @@ namespace tsl {
                 if (m_noClickableItems != ult::noClickableItems)
                     ult::noClickableItems = m_noClickableItems;
                 
-                renderer->fillScreen(a(defaultBackgroundColor));
-                renderer->drawWallpaper();
+                renderer->drawStaticBackground(a(defaultBackgroundColor), {
+                    {15, tsl::cfg::FramebufferHeight - 73, tsl::cfg::FramebufferWidth - 30, 1, a(botttomSeparatorColor)}
+                });
                 
                 y = 50;
                 offset = 0;
@@ -4360,8 +7917,6 @@ namespace tsl {
                 renderer->drawString(m_title, false, 20, 52, 32, a(defaultOverlayColor));
                 renderer->drawString(m_subtitle, false, 20, y+23, 15, a(versionTextColor));
             #endif
-            
-                renderer->drawRect(15, tsl::cfg::FramebufferHeight - 73, tsl::cfg::FramebufferWidth - 30, 1, a(botttomSeparatorColor));
                 
                 // Use getTextDimensions instead of calculateStringWidth
                 auto [backWidth, backHeight] = renderer->getTextDimensions(ult::BACK, false, 23);
@@ -4545,12 +8100,11 @@ namespace tsl {
                     tsl::initializeThemeVars(); // Initialize variables for ultrahand themes
                     ult::themeIsInitialized = true;
                 }
-                renderer->fillScreen(a(defaultBackgroundColor));
-                renderer->drawWallpaper();
                 //renderer->fillScreen(tsl::style::color::ColorFrameBackground);
-                renderer->drawRect(tsl::cfg::FramebufferWidth - 1, 0, 1, tsl::cfg::FramebufferHeight, a(0xF222));
-                
-                renderer->drawRect(15, tsl::cfg::FramebufferHeight - 73, tsl::cfg::FramebufferWidth - 30, 1, a(botttomSeparatorColor));
+                renderer->drawStaticBackground(a(defaultBackgroundColor), {
+                    {tsl::cfg::FramebufferWidth - 1, 0, 1, tsl::cfg::FramebufferHeight, a(0xF222)},
+                    {15, tsl::cfg::FramebufferHeight - 73, tsl::cfg::FramebufferWidth - 30, 1, a(botttomSeparatorColor)}
+                });
                 
                 //renderer->drawString(("\uE0E1  "+ult::BACK+"     \uE0E0  "+ult::OK), false, 30, 693, 23, a(defaultTextColor)); // CUSTOM MODIFICATION
                 
@@ -4758,17 +8312,20 @@ namespace tsl {
                 const s32 bottomBound = getBottomBound();
                 const s32 height = getHeight();
                 
-                renderer->enableScissoring(getLeftBound(), topBound-8, getWidth() + 8, height + 14);
-        
-                // Optimized visibility culling
-                for (Element* entry : m_items) {
-                    //const s32 entryBottom = entry->getBottomBound();
-                    if (entry->getBottomBound() > topBound && entry->getTopBound() < bottomBound) {
-                        entry->frame(renderer);
+                if (!drawScrolled(renderer, topBound, bottomBound)) {
+                    renderer->enableScissoring(getLeftBound(), topBound-8, getWidth() + 8, height + 14);
+            
+                    // Optimized visibility culling
+                    for (Element* entry : m_items) {
+                        //const s32 entryBottom = entry->getBottomBound();
+                        if (entry->getBottomBound() > topBound && entry->getTopBound() < bottomBound) {
+                            entry->frame(renderer);
+                        }
                     }
+                    
+                    renderer->disableScissoring();
                 }
-                
-                renderer->disableScissoring();
+                rememberDrawnFrame(renderer, topBound, bottomBound);
 
                 // FIXED: Check if content actually extends beyond viewport bounds
                 // Calculate the actual bottom position of the last item
@@ -4802,6 +8359,19 @@ namespace tsl {
             }
 
         
+            /**
+             * @brief Enables moving the previous frame's pixels instead of redrawing every item while scrolling
+             * @note Off by default: the copy touches every pixel of the viewport, which only pays off when the
+             *       items cost more to draw than that. Items are only reused when their
+             *       \ref Element::getDrawSignature() is known and unchanged, so custom items must implement it to
+             *       benefit.
+             *
+             * @param enabled Enabled
+             */
+            inline void setScrollBlitEnabled(bool enabled) {
+                m_scrollBlitEnabled = enabled;
+            }
+            
             virtual void layout(u16 parentX, u16 parentY, u16 parentWidth, u16 parentHeight) override {
                 s32 y = getY() - m_offset;
                 
@@ -5014,6 +8584,165 @@ namespace tsl {
             
             bool m_hasWrappedInCurrentSequence = false;
             NavigationResult m_lastNavigationResult = NavigationResult::None;
+            
+            // How far highlights, separators and shake animations reach past an item's bounds
+            static constexpr s32 ScrollBlitItemMargin = 12;
+            bool m_scrollBlitEnabled = false;
+            
+            /**
+             * @brief An item drawn in the last frame, with where it was and what it looked like
+             */
+            struct DrawnItem {
+                const Element* element;
+                s32 y;
+                u64 signature;
+            };
+            
+            /**
+             * @brief What the last frame drawn by this list looked like
+             */
+            struct DrawnFrame {
+                u32 number = UINT32_MAX;
+                u64 backgroundKey = 0;
+                s32 x = 0, width = 0, top = 0, bottom = 0;
+                s32 originY = 0, listHeight = 0;
+                size_t itemCount = 0;
+                const Element* first = nullptr;
+                const Element* last = nullptr;
+                const Element* focused = nullptr;
+                std::vector<DrawnItem> items;
+            } m_drawnFrame;
+            
+            /**
+             * @brief Records the state drawScrolled() compares the next frame against
+             */
+            void rememberDrawnFrame(gfx::Renderer* renderer, const s32 topBound, const s32 bottomBound) {
+                auto& drawn = m_drawnFrame;
+                drawn.number = renderer->getFrameNumber();
+                drawn.backgroundKey = renderer->getFrameBackgroundKey();
+                drawn.x = getLeftBound();
+                drawn.width = getWidth() + 8;
+                drawn.top = topBound;
+                drawn.bottom = bottomBound;
+                drawn.listHeight = m_listHeight;
+                drawn.itemCount = m_items.size();
+                drawn.first = m_items.empty() ? nullptr : m_items.front();
+                drawn.last = m_items.empty() ? nullptr : m_items.back();
+                drawn.originY = m_items.empty() ? 0 : m_items.front()->getY();
+                drawn.focused = nullptr;
+                drawn.items.clear();
+                if (!m_scrollBlitEnabled)
+                    return;
+                
+                for (Element* entry : m_items) {
+                    if (entry->hasFocus())
+                        drawn.focused = entry;
+                    if (entry->getBottomBound() > topBound && entry->getTopBound() < bottomBound)
+                        drawn.items.push_back({ entry, entry->getY(), entry->getDrawSignature() });
+                }
+            }
+            
+            /**
+             * @brief Draws the visible items overlapping rows [y0, y1) of the list area over a restored background
+             */
+            void redrawRows(gfx::Renderer* renderer, s32 y0, s32 y1, const s32 topBound, const s32 bottomBound) {
+                y0 = std::max(y0, topBound - 8);
+                y1 = std::min(y1, bottomBound + 6);
+                if (y0 >= y1)
+                    return;
+                
+                renderer->restoreBackground(getLeftBound(), y0, getWidth() + 8, y1 - y0);
+                renderer->enableScissoring(getLeftBound(), y0, getWidth() + 8, y1 - y0);
+                for (Element* entry : m_items) {
+                    if (entry->getBottomBound() > topBound && entry->getTopBound() < bottomBound &&
+                        entry->getBottomBound() + ScrollBlitItemMargin > y0 && entry->getTopBound() - ScrollBlitItemMargin < y1) {
+                        entry->frame(renderer);
+                    }
+                }
+                renderer->disableScissoring();
+            }
+            
+            /**
+             * @brief Draws a scrolled list by moving the previous frame's pixels by the scroll distance
+             * @note Only the strip scrolled into view, the margins around the viewport, the rows of the focused
+             *       items (now and in the previous frame) and the rows of every item that can't be shown to look
+             *       the same as in the previous frame are drawn again. An item is reused when it moved by exactly
+             *       the scroll distance and its draw signature is known and unchanged. This needs an immediate frame
+             *       on the same uniform background as the previous one and an unchanged item list.
+             *       Anything else returns false to draw normally.
+             *
+             * @return true when the list was drawn
+             */
+            bool drawScrolled(gfx::Renderer* renderer, const s32 topBound, const s32 bottomBound) {
+                if (!m_scrollBlitEnabled || m_items.empty())
+                    return false;
+                
+                const auto& drawn = m_drawnFrame;
+                const s32 dy = m_items.front()->getY() - drawn.originY;
+                if (dy == 0 || std::abs(dy) >= bottomBound - topBound)
+                    return false;
+                
+                const u64 backgroundKey = renderer->getFrameBackgroundKey();
+                if (backgroundKey == 0 || backgroundKey != drawn.backgroundKey || drawn.number + 1 != renderer->getFrameNumber() ||
+                    drawn.x != getLeftBound() || drawn.width != getWidth() + 8 || drawn.top != topBound || drawn.bottom != bottomBound ||
+                    drawn.listHeight != m_listHeight || drawn.itemCount != m_items.size() ||
+                    drawn.first != m_items.front() || drawn.last != m_items.back())
+                    return false;
+                
+            #if FRAME_PROFILER_DIRECTIVE
+                // The HUD is drawn over the list after it
+                if (profiler::isHudVisible())
+                    return false;
+            #endif
+                
+                // Rows to draw again: the focused items (now and in the previous frame), every item whose pixels in
+                // the previous frame can't be reused, the strip scrolled into view and the margins around the viewport
+                std::vector<std::pair<s32, s32>> rows;
+                bool previousFound = drawn.focused == nullptr;
+                for (Element* entry : m_items) {
+                    if (entry == drawn.focused)
+                        previousFound = true;
+                    if (entry != drawn.focused && !entry->hasFocus()) {
+                        if (entry->getBottomBound() <= topBound || entry->getTopBound() >= bottomBound)
+                            continue;
+                        
+                        const u64 signature = entry->getDrawSignature();
+                        const auto previous = std::find_if(drawn.items.begin(), drawn.items.end(),
+                                                           [entry](const DrawnItem& item) { return item.element == entry; });
+                        if (signature != 0 && previous != drawn.items.end() && previous->y + dy == entry->getY() &&
+                            previous->signature == signature)
+                            continue;
+                    }
+                    rows.emplace_back(entry->getTopBound() - ScrollBlitItemMargin, entry->getBottomBound() + ScrollBlitItemMargin);
+                }
+                if (!previousFound)
+                    return false;
+                
+                if (dy < 0)
+                    rows.emplace_back(bottomBound + dy, bottomBound);
+                else
+                    rows.emplace_back(topBound, topBound + dy);
+                rows.emplace_back(topBound - 8, topBound);
+                rows.emplace_back(bottomBound, bottomBound + 6);
+                
+                if (!renderer->scrollPreviousFrame(getLeftBound(), topBound, getWidth() + 8, bottomBound - topBound, dy))
+                    return false;
+                
+                // Each item is drawn at most once, the focused one draws its highlight past the scissor, and animated
+                // items must not advance twice in a frame, so overlapping and touching ranges are merged first
+                std::sort(rows.begin(), rows.end());
+                s32 y0 = rows.front().first, y1 = rows.front().second;
+                for (const auto& [from, to] : rows) {
+                    if (from > y1 + 2 * ScrollBlitItemMargin) {
+                        redrawRows(renderer, y0, y1, topBound, bottomBound);
+                        y0 = from;
+                    }
+                    y1 = std::max(y1, to);
+                }
+                redrawRows(renderer, y0, y1, topBound, bottomBound);
+                
+                return true;
+            }
         
         private:
             // Method to explicitly preserve cache when navigating away
@@ -5250,6 +8979,7 @@ namespace tsl {
                             if (prevOffset != m_offset) {
                                 invalidate();
                                 prevOffset = m_offset;
+                                governor::requestFrames();
                             }
                             return;
                         }
@@ -5267,6 +8997,7 @@ namespace tsl {
                         if (prevOffset != m_offset) {
                             invalidate();
                             prevOffset = m_offset;
+                            governor::requestFrames();
                         }
                         return;
                     }
@@ -5327,6 +9058,7 @@ namespace tsl {
                 if (prevOffset != m_offset) {
                     invalidate();
                     prevOffset = m_offset;
+                    governor::requestFrames();
                 }
             }
                                                         
@@ -6086,6 +9818,19 @@ namespace tsl {
                 return m_value;
             }
 
+            virtual u64 getDrawSignature() override {
+                // The throbber and the interpreter progress colors change without the item noticing
+                if (m_value == ult::INPROGRESS_SYMBOL || m_value.find(ult::DOWNLOAD_SYMBOL) != std::string::npos ||
+                    m_value.find(ult::UNZIP_SYMBOL) != std::string::npos || m_value.find(ult::COPY_SYMBOL) != std::string::npos)
+                    return 0;
+
+                const bool useClickTextColor = m_touched && Element::getInputMode() == InputMode::Touch && ult::touchInBounds;
+                return gfx::DisplayList::hash("ListItem", m_text, m_value, m_faint, m_maxWidth, m_listItemHeight, getX(), getWidth(),
+                                              getHeight(), useClickTextColor, determineValueTextColor(useClickTextColor, false),
+                                              defaultTextColor, clickTextColor, clickColor, separatorColor, starColor,
+                                              selectionStarColor) | 1;
+            }
+
             //virtual bool matchesJumpCriteria(const std::string& jumpText, const std::string& jumpValue) const override {
             //    return matchesJumpCriteria(jumpText, jumpValue, true); // Default to exact match
             //}
@@ -6691,6 +10436,10 @@ namespace tsl {
                 // Intentionally left blank
             }
             
+            virtual u64 getDrawSignature() override {
+                return gfx::DisplayList::hash("DummyListItem") | 1;
+            }
+            
             // Override the layout method to set the dimensions to zero
             virtual void layout(u16 parentX, u16 parentY, u16 parentWidth, u16 parentHeight) override {
                 //this->setBoundaries(parentX, parentY, 0, 0); // Zero size
@@ -6737,6 +10486,11 @@ namespace tsl {
                 //    renderer->drawRect(this->getX(), this->getBottomBound(), this->getWidth(), 1, tsl::style::color::ColorFrame); // CUSTOM MODIFICATION
             }
             
+            virtual u64 getDrawSignature() override {
+                return gfx::DisplayList::hash("CategoryHeader", this->m_text, this->m_hasSeparator, this->getX(), this->getHeight(),
+                                              headerSeparatorColor, headerTextColor) | 1;
+            }
+            
             virtual void layout(u16 parentX, u16 parentY, u16 parentWidth, u16 parentHeight) override {
                 // Check if the CategoryHeader is part of a list and if it's the first entry in it, half it's height
                 if (List *list = static_cast<List*>(this->getParent()); list != nullptr) {
@@ -8008,6 +11762,205 @@ namespace tsl {
         
     }
     
+    #if RENDER_BENCHMARK_DIRECTIVE
+    namespace bench {
+        
+        /**
+         * @brief Timing of one benchmark case
+         */
+        struct BenchmarkResult {
+            std::string name;    ///< Primitive or scene
+            std::string config;  ///< "single", "multi" or "frame"
+            u32 iterations = 0;
+            u64 pixels = 0;      ///< Pixels covered per iteration (0 for full scenes)
+            double nsPerIteration = 0.0;
+            double nsPerPixel = 0.0;
+        };
+        
+        /**
+         * @brief Rendering micro-benchmarks for the drawing primitives and representative scenes
+         * @note Runs on the hardware framebuffer or headless; an uninitialized renderer is brought up
+         *       headless. Multithreaded cases are only reported when the render worker pool has
+         *       workers (ult::numThreads > 1). Scenes go through elm::List, whose frame cache they replace, so run
+         *       this outside of a live Gui. Overlays built with RENDER_BENCHMARK_DIRECTIVE call runAndReport()
+         *       from tsl::loop before their first Gui is loaded.
+         */
+        class RenderBenchmark {
+        public:
+            /**
+             * @brief Runs every benchmark case
+             *
+             * @param iterations Iterations per case
+             * @return Results in run order
+             */
+            static std::vector<BenchmarkResult> run(u32 iterations = 50) {
+                auto& renderer = gfx::Renderer::get();
+                if (!renderer.m_initialized)
+                    renderer.initHeadless();
+                
+                iterations = std::max<u32>(iterations, 1);
+                std::vector<BenchmarkResult> results;
+                
+                const s32 width = cfg::FramebufferWidth;
+                const s32 height = cfg::FramebufferHeight;
+                const u64 screenPixels = static_cast<u64>(width) * height;
+                const Color fillColor = {0x2, 0x4, 0x8, 0xC};
+                
+                measure(results, "drawRect", "single", iterations, screenPixels, [&] {
+                    renderer.drawRect(0, 0, width, height, fillColor);
+                });
+                
+                measure(results, "drawRoundedRect", "single", iterations, screenPixels, [&] {
+                    renderer.drawRoundedRectSingleThreaded(0, 0, width, height, 12, fillColor);
+                });
+                if (renderer.m_workerPool.size() > 1) {
+                    measure(results, "drawRoundedRect", "multi", iterations, screenPixels, [&] {
+                        renderer.drawRoundedRectMultiThreaded(0, 0, width, height, 12, fillColor);
+                    });
+                }
+                
+                // Full-screen bitmap, the same work drawWallpaper does with a loaded wallpaper
+                std::vector<u8> bitmap(screenPixels * 2);
+                for (size_t i = 0; i < bitmap.size(); ++i)
+                    bitmap[i] = static_cast<u8>(i * 37);
+                const u8* wallpaper = (!ult::wallpaperData.empty() && ult::correctFrameSize) ? ult::wallpaperData.data() : bitmap.data();
+                
+                measure(results, "drawBitmapRGBA4444", "single", iterations, screenPixels, [&] {
+                    renderer.processBMPChunk(0, 0, width, wallpaper, 0, height);
+                });
+                if (renderer.m_workerPool.size() > 1) {
+                    measure(results, "drawBitmapRGBA4444", "multi", iterations, screenPixels, [&] {
+                        renderer.drawBitmapRGBA4444(0, 0, width, height, wallpaper);
+                    });
+                }
+                
+                const std::string text = "Ultrahand Overlay 0123456789";
+                const auto textSize = renderer.getTextDimensions(text, false, 23);
+                measure(results, "drawString", "single", iterations,
+                        static_cast<u64>(std::max(textSize.first, 0)) * std::max(textSize.second, 0), [&] {
+                    renderer.drawString(text, false, 20, 100, 23, Color{0xF, 0xF, 0xF, 0xF});
+                });
+                
+                // Representative scenes, drawn as full frames
+                measureScene(results, "scene_main_menu", iterations, [](elm::List* list) {
+                    for (u32 i = 0; i < 8; ++i)
+                        list->addItem(new elm::ListItem("Menu entry " + std::to_string(i), ult::DROPDOWN_SYMBOL));
+                });
+                measureScene(results, "scene_package_list", iterations, [](elm::List* list) {
+                    list->addItem(new elm::CategoryHeader("Packages"));
+                    for (u32 i = 0; i < 200; ++i)
+                        list->addItem(new elm::ListItem("Package " + std::to_string(i), "v1." + std::to_string(i % 10)));
+                });
+                measureScene(results, "scene_trackbar_page", iterations, [](elm::List* list) {
+                    list->addItem(new elm::CategoryHeader("Trackbars"));
+                    for (u32 i = 0; i < 4; ++i) {
+                        auto* trackBar = new elm::StepTrackBar("\uE13C", 11);
+                        trackBar->setProgress(i * 25);
+                        list->addItem(trackBar);
+                    }
+                });
+                
+                return results;
+            }
+            
+            /**
+             * @brief Runs every benchmark case and writes the results as JSON
+             *
+             * @param path Output path
+             * @param iterations Iterations per case
+             * @return true if the report was written
+             */
+            static bool runAndReport(const std::string& path = ult::SETTINGS_PATH + "render_benchmark.json", u32 iterations = 50) {
+                const bool written = writeReport(run(iterations), path);
+                ult::logMessage((written ? "Render benchmark written to " : "Render benchmark could not be written to ") + path);
+                return written;
+            }
+            
+            /**
+             * @brief Writes results as JSON
+             *
+             * @param results Results from run()
+             * @param path Output path
+             * @return true on success
+             */
+            static bool writeReport(const std::vector<BenchmarkResult>& results, const std::string& path) {
+                std::string report = "{\n  \"framebuffer\": [" + std::to_string(cfg::FramebufferWidth) + ", " +
+                                     std::to_string(cfg::FramebufferHeight) + "],\n  \"threads\": " +
+                                     std::to_string(ult::numThreads) + ",\n  \"results\": [\n";
+                
+                char line[256];
+                for (size_t i = 0; i < results.size(); ++i) {
+                    const auto& result = results[i];
+                    snprintf(line, sizeof(line),
+                             "    {\"name\": \"%s\", \"config\": \"%s\", \"iterations\": %u, \"pixels\": %llu, "
+                             "\"ns_per_iteration\": %.1f, \"ns_per_pixel\": %.4f}%s\n",
+                             result.name.c_str(), result.config.c_str(), result.iterations,
+                             static_cast<unsigned long long>(result.pixels), result.nsPerIteration, result.nsPerPixel,
+                             (i + 1 < results.size()) ? "," : "");
+                    report += line;
+                }
+                report += "  ]\n}\n";
+                
+                FILE* file = fopen(path.c_str(), "w");
+                if (!file)
+                    return false;
+                const bool written = fwrite(report.data(), 1, report.size(), file) == report.size();
+                fclose(file);
+                return written;
+            }
+            
+        private:
+            template<typename Fn>
+            static void measure(std::vector<BenchmarkResult>& results, const char* name, const char* config,
+                                u32 iterations, u64 pixels, Fn&& draw) {
+                auto& renderer = gfx::Renderer::get();
+                
+                // Warm-up frame so glyph and layout caches are populated before timing
+                renderer.startFrame();
+                draw();
+                renderer.endFrame();
+                
+                // Draws go straight to the framebuffer, recording would only time the display list
+                renderer.startFrame();
+                renderer.m_recording = false;
+                
+                const auto start = std::chrono::steady_clock::now();
+                for (u32 i = 0; i < iterations; ++i)
+                    draw();
+                const auto end = std::chrono::steady_clock::now();
+                
+                renderer.endFrame();
+                
+                BenchmarkResult result;
+                result.name = name;
+                result.config = config;
+                result.iterations = iterations;
+                result.pixels = pixels;
+                result.nsPerIteration = std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+                result.nsPerPixel = pixels ? result.nsPerIteration / pixels : 0.0;
+                results.push_back(std::move(result));
+            }
+            
+            template<typename Populate>
+            static void measureScene(std::vector<BenchmarkResult>& results, const char* name, u32 iterations, Populate&& populate) {
+                auto* frame = new elm::OverlayFrame("Ultrahand", "Benchmark");
+                auto* list = new elm::List();
+                populate(list);
+                frame->setContent(list);
+                frame->layout(0, 0, cfg::FramebufferWidth, cfg::FramebufferHeight);
+                
+                auto& renderer = gfx::Renderer::get();
+                measure(results, name, "frame", iterations, 0, [&] {
+                    renderer.fillScreen(Color{0x0, 0x0, 0x0, 0x0});
+                    frame->frame(&renderer);
+                });
+                
+                delete frame;
+            }
+        };
+    }
+    #endif
+    
     // GUI
     
     /**
@@ -8464,14 +12417,30 @@ namespace tsl {
         #if IS_LAUNCHER_DIRECTIVE
             if (ult::launchingOverlay)
                 return;
+        #endif
+        #if FRAME_PROFILER_DIRECTIVE
+            profiler::beginFrame();
         #endif
             renderer.startFrame();
             
             this->animationLoop();
-            this->getCurrentGui()->update();
-            this->getCurrentGui()->draw(&renderer);
+            {
+                TSL_PROFILE_PHASE(Update);
+                this->getCurrentGui()->update();
+            }
+            {
+                TSL_PROFILE_PHASE(Draw);
+                this->getCurrentGui()->draw(&renderer);
+            }
+        #if FRAME_PROFILER_DIRECTIVE
+            if (profiler::isHudVisible())
+                profiler::drawHud(&renderer);
+        #endif
             
             renderer.endFrame();
+        #if FRAME_PROFILER_DIRECTIVE
+            profiler::endFrame();
+        #endif
         }
         
         // Calculate transition using ease-in-out curve instead of linear
@@ -8880,8 +12849,10 @@ namespace tsl {
             
             // Push the new Gui onto the stack
             this->m_guiStack.push(std::move(gui));
-            if (clearGlyphCache)
+            if (clearGlyphCache) {
                 tsl::gfx::FontManager::clearCache();
+                tsl::gfx::FontManager::preloadStandardGlyphsAsync();
+            }
             return this->m_guiStack.top();
         }
 
@@ -8969,6 +12940,7 @@ namespace tsl {
             bool running = false;
             
             Event comboEvent = { 0 };
+            Event wakeEvent = { 0 };
             
             bool overlayOpen = false;
             
@@ -9247,6 +13219,7 @@ namespace tsl {
                         if (shData->overlayOpen) {
                             tsl::Overlay::get()->hide();
                             shData->overlayOpen = false;
+                            governor::wake();
                         }
                         else {
                             eventFire(&shData->comboEvent);
@@ -9307,6 +13280,7 @@ namespace tsl {
                                         // Properly close the overlay to trigger the launch
                                         tsl::Overlay::get()->close();
                                         eventFire(&shData->comboEvent);
+                                        governor::wake();
                                         break;
                                         // DON'T set shData->running = false here!
                                     }
@@ -9318,6 +13292,10 @@ namespace tsl {
                 #endif
                     
                     shData->keysDownPending |= shData->keysDown;
+                    
+                    // Held buttons include stick directions
+                    if (shData->overlayOpen && (shData->keysDownPending || shData->keysHeld || shData->touchState.count))
+                        governor::wake();
                 }
                 
                 //20 ms
@@ -9328,6 +13306,7 @@ namespace tsl {
                         if (shData->overlayOpen) {
                             tsl::Overlay::get()->hide();
                             shData->overlayOpen = false;
+                            governor::wake();
                         }
                     }
                     
@@ -9563,6 +13542,10 @@ namespace tsl {
         
         shData.running = true;
         
+        // Published before the poller starts, it may call governor::wake() right away
+        eventCreate(&shData.wakeEvent, true);
+        governor::s_wakeEvent.store(&shData.wakeEvent, std::memory_order_release);
+        
         Thread backgroundThread;
         threadCreate(&backgroundThread, impl::backgroundEventPoller, &shData, nullptr, 0x1000, 0x2c, -2);
         threadStart(&backgroundThread);
@@ -9582,6 +13565,15 @@ namespace tsl {
         tsl::initializeUltrahandSettings(); // for initializing settings
     #endif
         overlay->initScreen();
+    #if USING_WIDGET_DIRECTIVE
+        // Sampled in the background from here on, stopped again below before the services close
+        widget::setSensors(widget::getShownSensors());
+        widget::startSampling();
+    #endif
+    #if RENDER_BENCHMARK_DIRECTIVE
+        // Before the first Gui, the benchmark scenes replace elm::List's frame cache
+        bench::RenderBenchmark::runAndReport();
+    #endif
         overlay->changeTo(overlay->loadInitialGui());
 
 
@@ -9621,10 +13613,14 @@ namespace tsl {
             overlay->show();
             overlay->clearScreen();
             
+            bool activeFrame;
+            u64 idleWaitNs;
+            
             while (shData.running) {
                 overlay->loop();
                 {
                     std::scoped_lock lock(shData.dataMutex);
+                    activeFrame = shData.keysDownPending || shData.keysHeld || shData.touchState.count || overlay->fadeAnimationPlaying();
                     if (!overlay->fadeAnimationPlaying()) {
                         overlay->handleInput(shData.keysDownPending, shData.keysHeld, shData.touchState.count, shData.touchState.touches[0], shData.joyStickPosLeft, shData.joyStickPosRight);
                     }
@@ -9637,7 +13633,14 @@ namespace tsl {
                 
                 if (overlay->shouldClose())
                     shData.running = false;
+                
+                // Nothing moved for a while, so sleep until input, a frame request or the idle refresh
+                idleWaitNs = governor::frameFinished(activeFrame || ult::runningInterpreter.load(std::memory_order_acquire));
+                if (idleWaitNs != 0 && shData.running)
+                    eventWait(&shData.wakeEvent, idleWaitNs);
             }
+            // Start the next show at full rate
+            governor::frameFinished(true);
             
             overlay->clearScreen();
             overlay->resetFlags();
@@ -9654,6 +13657,15 @@ namespace tsl {
         threadWaitForExit(&backgroundThread);
         threadClose(&backgroundThread);
         
+    #if USING_WIDGET_DIRECTIVE
+        // The sampler wakes the governor too and reads sensors whose services close with the overlay
+        widget::stopSampling();
+    #endif
+        
+        // The poller is gone, nothing can fire the wake event anymore
+        governor::s_wakeEvent.store(nullptr, std::memory_order_release);
+        eventClose(&shData.wakeEvent);
+        
         overlay->exitScreen();
         overlay->exitServices();
         
@@ -34,7 +34,9 @@
 
 #include <ultra.hpp>
 #include <switch.h>
+#if defined(__ARM_NEON)
 #include <arm_neon.h>
+#endif
 
 #include <stdlib.h>
 #include <strings.h>
@@ -170,6 +172,7 @@ namespace ult {
     //bool useCustomWallpaper = false;
     extern bool useMemoryExpansion;
     extern bool useOpaqueScreenshots;
+    extern bool useWallpaperDithering;
     
     extern bool onTrackBar;
     extern bool allowSlide;
@@ -499,6 +502,7 @@ namespace ult {
     
     extern std::atomic<bool> refreshWallpaper;
     extern std::vector<u8> wallpaperData;
+    extern std::atomic<u32> wallpaperGeneration; // Bumped whenever wallpaperData is loaded, reloaded or cleared
     extern std::atomic<bool> inPlot;
     
     extern std::mutex wallpaperMutex;
@@ -506,6 +510,13 @@ namespace ult {
     
     
     
+    // Packs RGBA8888 pixels into RGBA4444 (r << 4 | g, b << 4 | a per pixel), vectorized where available.
+    // With dither, an ordered 4x4 pattern phased by the screen position (x, y) of the first pixel is applied to RGB.
+    void convertRGBA8888ToRGBA4444(const u8* input, u8* output, size_t pixelCount, bool dither = false, u32 x = 0, u32 y = 0);
+    
+    // Path of the packed RGBA4444 cache kept next to a legacy .rgba wallpaper
+    std::string getPackedWallpaperPath(const std::string& filePath);
+    
     // Function to load the RGBA file into memory and modify wallpaperData directly
     void loadWallpaperFile(const std::string& filePath, s32 width = 448, s32 height = 720);
     void loadWallpaperFileWhenSafe();
@@ -620,15 +631,23 @@ namespace ult {
     
     // Number of renderer threads to use
     extern const unsigned numThreads;
-    extern std::vector<std::thread> threads;
-    extern s32 bmpChunkSize;
-    extern std::atomic<s32> currentRow;
-    
     
+    // No longer used by libtesla, rendering runs on tsl::gfx::RenderWorkerPool.
+    // Kept so overlays that still reference them keep building.
+    [[deprecated("unused, rendering runs on tsl::gfx::RenderWorkerPool")]] extern std::vector<std::thread> threads;
+    [[deprecated("unused, rendering runs on tsl::gfx::RenderWorkerPool")]] extern s32 bmpChunkSize;
+    [[deprecated("unused, rendering runs on tsl::gfx::RenderWorkerPool")]] extern std::atomic<s32> currentRow;
     
-    static std::barrier inPlotBarrier(numThreads, [](){
+    // GCC flags the deprecated barrier's own static initializer otherwise
+    #pragma GCC diagnostic push
+    #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+    [[deprecated("unused, drawWallpaper clears ult::inPlot itself")]] static std::barrier inPlotBarrier(numThreads, [](){
         inPlot.store(false, std::memory_order_release);
     });
+    #pragma GCC diagnostic pop
+    
+    
+    
 
 
     //extern std::atomic<unsigned int> barrierCounter;
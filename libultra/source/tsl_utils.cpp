@@ -21,6 +21,9 @@
 #include <tsl_utils.hpp>
 
 #include <cstdlib>
+#if !defined(__ARM_NEON) && defined(__SSE2__)
+#include <emmintrin.h> // Host builds use the SSE2 conversion kernel
+#endif
 extern "C" { // assertion override
     void __assert_func(const char *_file, int _line, const char *_func, const char *_expr ) {
         abort();
@@ -253,6 +256,7 @@ namespace ult {
     //bool useCustomWallpaper = false;
     bool useMemoryExpansion = false;
     bool useOpaqueScreenshots = false;
+    bool useWallpaperDithering = false;
     
     bool onTrackBar = false;
     bool allowSlide = false;
@@ -1081,79 +1085,298 @@ namespace ult {
     
     std::atomic<bool> refreshWallpaper(false);
     std::vector<u8> wallpaperData; 
+    std::atomic<u32> wallpaperGeneration(0);
     std::atomic<bool> inPlot(false);
     
     std::mutex wallpaperMutex;
     std::condition_variable cv;
     
     
-    // Function to load the RGBA file into memory and modify wallpaperData directly
-    void loadWallpaperFile(const std::string& filePath, s32 width, s32 height) {
-        size_t originalDataSize = width * height * 4; // Original size in bytes (4 bytes per pixel)
-        size_t compressedDataSize = originalDataSize / 2; // RGBA4444 uses half the space
-        
-        wallpaperData.resize(compressedDataSize);
+    // Packed wallpapers are quantized RGBA4444, run-length encoded and cached next to the legacy RGBA8888 file.
+    // The header records the size and modification time of the source so a replaced .rgba file is re-packed.
+    static constexpr u32 PACKED_WALLPAPER_MAGIC = 0x31505755; // "UWP1"
+    static constexpr size_t WALLPAPER_IO_CHUNK_SIZE = 16 * 1024;
     
-        if (!isFileOrDirectory(filePath)) {
-            wallpaperData.clear();
-            return;
+    static constexpr u32 PACKED_WALLPAPER_DITHERED = 1 << 0;
+    
+    struct PackedWallpaperHeader {
+        u32 magic;
+        u16 width;
+        u16 height;
+        u32 flags;
+        u32 reserved;
+        u64 sourceSize;
+        s64 sourceTime;
+    };
+    
+    
+    // 4x4 Bayer thresholds scaled to one RGBA4444 step (0-15), added before the channels are truncated
+    static constexpr u8 DITHER_MATRIX[4][4] = {
+        { 0,  8,  2, 10},
+        {12,  4, 14,  6},
+        { 3, 11,  1,  9},
+        {15,  7, 13,  5}
+    };
+    
+    static void convertRGBA8888ToRGBA4444Scalar(const u8* input, u8* output, size_t pixelCount, const u8* thresholds, u32 phase) {
+        for (size_t i = 0; i < pixelCount; ++i, input += 4, output += 2) {
+            const u8 t = thresholds[(phase + i) & 3];
+            const u8 r = std::min(input[0] + t, 0xFF), g = std::min(input[1] + t, 0xFF), b = std::min(input[2] + t, 0xFF);
+            output[0] = (r & 0xF0) | (g >> 4);
+            output[1] = (b & 0xF0) | (input[3] >> 4);
         }
+    }
     
-        #if NO_FSTREAM_DIRECTIVE
-            FILE* file = fopen(filePath.c_str(), "rb");
-            if (!file) {
-                wallpaperData.clear();
-                return;
-            }
+    void convertRGBA8888ToRGBA4444(const u8* input, u8* output, size_t pixelCount, bool dither, u32 x, u32 y) {
+        static constexpr u8 noDither[4] = {0, 0, 0, 0};
+        const u8* const thresholds = dither ? DITHER_MATRIX[y & 3] : noDither;
+        size_t i = 0;
+        
+    #if defined(__ARM_NEON)
+        // 16 pixels per iteration, deinterleaved into channel registers
+        uint8x16_t threshold = vdupq_n_u8(0);
+        if (dither) {
+            u8 lanes[16];
+            for (int lane = 0; lane < 16; ++lane)
+                lanes[lane] = thresholds[(x + lane) & 3];
+            threshold = vld1q_u8(lanes);
+        }
+        const uint8x16_t high = vdupq_n_u8(0xF0);
+        for (; i + 16 <= pixelCount; i += 16) {
+            const uint8x16x4_t px = vld4q_u8(input + i * 4);
+            uint8x16x2_t out;
+            out.val[0] = vorrq_u8(vandq_u8(vqaddq_u8(px.val[0], threshold), high), vshrq_n_u8(vqaddq_u8(px.val[1], threshold), 4));
+            out.val[1] = vorrq_u8(vandq_u8(vqaddq_u8(px.val[2], threshold), high), vshrq_n_u8(px.val[3], 4));
+            vst2q_u8(output + i * 2, out);
+        }
+    #elif defined(__SSE2__)
+        // 16 pixels per iteration; each 32-bit lane holds r | g << 8 | b << 16 | a << 24
+        __m128i threshold = _mm_setzero_si128();
+        if (dither) {
+            u32 lanes[4];
+            for (int lane = 0; lane < 4; ++lane)
+                lanes[lane] = thresholds[(x + lane) & 3] * 0x010101u;
+            threshold = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lanes));
+        }
+        const __m128i lowMask = _mm_set1_epi32(0xF0);
+        const __m128i nibbleMask = _mm_set1_epi32(0x0F);
+        auto convert4 = [&](const u8* src) {
+            const __m128i px = _mm_adds_epu8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src)), threshold);
+            const __m128i lo = _mm_or_si128(_mm_and_si128(px, lowMask), _mm_and_si128(_mm_srli_epi32(px, 12), nibbleMask));
+            const __m128i hi = _mm_or_si128(_mm_and_si128(_mm_srli_epi32(px, 16), lowMask), _mm_srli_epi32(px, 28));
+            const __m128i out = _mm_or_si128(lo, _mm_slli_epi32(hi, 8));
+            return _mm_srai_epi32(_mm_slli_epi32(out, 16), 16); // sign-extend so the saturating pack is exact
+        };
+        for (; i + 16 <= pixelCount; i += 16) {
+            const u8* src = input + i * 4;
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i * 2), _mm_packs_epi32(convert4(src), convert4(src + 16)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i * 2 + 16), _mm_packs_epi32(convert4(src + 32), convert4(src + 48)));
+        }
+    #endif
+        
+        convertRGBA8888ToRGBA4444Scalar(input + i * 4, output + i * 2, pixelCount - i, thresholds, x + static_cast<u32>(i));
+    }
     
-            std::vector<uint8_t> buffer(originalDataSize);
-            size_t bytesRead = fread(buffer.data(), 1, originalDataSize, file);
-            fclose(file);
     
-            if (bytesRead != originalDataSize) {
-                wallpaperData.clear();
-                return;
+    std::string getPackedWallpaperPath(const std::string& filePath) {
+        const size_t dotPos = filePath.rfind('.');
+        const size_t slashPos = filePath.rfind('/');
+        
+        if (dotPos == std::string::npos || (slashPos != std::string::npos && dotPos < slashPos))
+            return filePath + ".rle";
+        return filePath.substr(0, dotPos) + ".rle";
+    }
+    
+    
+    // Decodes a packed wallpaper straight into wallpaperData through a small read buffer
+    static bool loadPackedWallpaper(const std::string& packedPath, const struct stat& source, s32 width, s32 height, u32 flags) {
+        FILE* file = fopen(packedPath.c_str(), "rb");
+        if (!file)
+            return false;
+        
+        PackedWallpaperHeader header;
+        if (fread(&header, sizeof(header), 1, file) != 1 ||
+            header.magic != PACKED_WALLPAPER_MAGIC ||
+            header.width != width || header.height != height || header.flags != flags ||
+            header.sourceSize != static_cast<u64>(source.st_size) ||
+            header.sourceTime != static_cast<s64>(source.st_mtime)) {
+            fclose(file);
+            return false;
+        }
+        
+        std::vector<u8> buffer(WALLPAPER_IO_CHUNK_SIZE);
+        size_t bufferPos = 0, bufferEnd = 0;
+        
+        auto readBytes = [&](u8* dst, size_t count) -> bool {
+            while (count > 0) {
+                if (bufferPos == bufferEnd) {
+                    bufferEnd = fread(buffer.data(), 1, buffer.size(), file);
+                    bufferPos = 0;
+                    if (bufferEnd == 0)
+                        return false;
+                }
+                const size_t chunk = std::min(count, bufferEnd - bufferPos);
+                std::memcpy(dst, buffer.data() + bufferPos, chunk);
+                bufferPos += chunk;
+                dst += chunk;
+                count -= chunk;
+            }
+            return true;
+        };
+        
+        u8* output = wallpaperData.data();
+        u8* const outputEnd = output + wallpaperData.size();
+        bool success = true;
+        u8 control, pixel[2];
+        
+        while (output < outputEnd) {
+            if (!readBytes(&control, 1)) {
+                success = false;
+                break;
+            }
+            
+            // 0-127: literal run of control+1 pixels, 128-255: control-126 copies of one pixel
+            const size_t bytes = (control < 128 ? control + 1 : control - 126) * 2;
+            if (bytes > static_cast<size_t>(outputEnd - output)) {
+                success = false;
+                break;
             }
+            
+            if (control < 128) {
+                if (!readBytes(output, bytes)) {
+                    success = false;
+                    break;
+                }
+                output += bytes;
+            } else {
+                if (!readBytes(pixel, 2)) {
+                    success = false;
+                    break;
+                }
+                for (u8* const runEnd = output + bytes; output < runEnd; output += 2) {
+                    output[0] = pixel[0];
+                    output[1] = pixel[1];
+                }
+            }
+        }
+        
+        fclose(file);
+        return success;
+    }
     
-        #else
-            std::ifstream file(filePath, std::ios::binary);
-            if (!file) {
-                wallpaperData.clear();
-                return;
+    
+    // Converts a legacy RGBA8888 wallpaper into wallpaperData one chunk at a time
+    static bool loadLegacyWallpaper(const std::string& filePath, s32 width) {
+        FILE* file = fopen(filePath.c_str(), "rb");
+        if (!file)
+            return false;
+        
+        // Whole rows per chunk keep the dither pattern aligned to the screen
+        const size_t rowSize = static_cast<size_t>(width) * 4;
+        const size_t rowsPerChunk = std::max<size_t>(1, WALLPAPER_IO_CHUNK_SIZE / rowSize);
+        std::vector<u8> buffer(rowsPerChunk * rowSize);
+        u8* output = wallpaperData.data();
+        const u32 rows = static_cast<u32>(wallpaperData.size() / (rowSize / 2));
+        
+        for (u32 row = 0; row < rows; ) {
+            const u32 chunkRows = std::min<u32>(rowsPerChunk, rows - row);
+            if (fread(buffer.data(), 1, chunkRows * rowSize, file) != chunkRows * rowSize) {
+                fclose(file);
+                return false;
             }
+            for (u32 i = 0; i < chunkRows; ++i, ++row, output += rowSize / 2)
+                convertRGBA8888ToRGBA4444(buffer.data() + i * rowSize, output, width, useWallpaperDithering, 0, row);
+        }
+        
+        fclose(file);
+        return true;
+    }
     
-            std::vector<uint8_t> buffer(originalDataSize);
-            file.read(reinterpret_cast<char*>(buffer.data()), originalDataSize);
-            if (!file) {
-                wallpaperData.clear();
-                return;
+    
+    // Packs wallpaperData so the next load skips the conversion; failures only cost the cache
+    static void writePackedWallpaper(const std::string& packedPath, const struct stat& source, s32 width, s32 height, u32 flags) {
+        FILE* file = fopen(packedPath.c_str(), "wb");
+        if (!file)
+            return;
+        
+        const PackedWallpaperHeader header = {
+            PACKED_WALLPAPER_MAGIC,
+            static_cast<u16>(width),
+            static_cast<u16>(height),
+            flags,
+            0,
+            static_cast<u64>(source.st_size),
+            static_cast<s64>(source.st_mtime)
+        };
+        bool success = fwrite(&header, sizeof(header), 1, file) == 1;
+        
+        const u8* const data = wallpaperData.data();
+        const size_t pixelCount = wallpaperData.size() / 2;
+        auto samePixel = [data](size_t a, size_t b) {
+            return data[a * 2] == data[b * 2] && data[a * 2 + 1] == data[b * 2 + 1];
+        };
+        
+        std::vector<u8> buffer;
+        buffer.reserve(WALLPAPER_IO_CHUNK_SIZE + 257);
+        
+        for (size_t i = 0; i < pixelCount && success; ) {
+            size_t run = 1;
+            while (i + run < pixelCount && run < 129 && samePixel(i, i + run))
+                ++run;
+            
+            if (run >= 2) {
+                buffer.push_back(static_cast<u8>(run + 126));
+                buffer.push_back(data[i * 2]);
+                buffer.push_back(data[i * 2 + 1]);
+                i += run;
+            } else {
+                size_t literal = 1;
+                while (i + literal < pixelCount && literal < 128 &&
+                       !(i + literal + 1 < pixelCount && samePixel(i + literal, i + literal + 1)))
+                    ++literal;
+                
+                buffer.push_back(static_cast<u8>(literal - 1));
+                buffer.insert(buffer.end(), data + i * 2, data + (i + literal) * 2);
+                i += literal;
             }
-        #endif
+            
+            if (buffer.size() >= WALLPAPER_IO_CHUNK_SIZE) {
+                success = fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size();
+                buffer.clear();
+            }
+        }
+        
+        if (success && !buffer.empty())
+            success = fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size();
+        
+        fclose(file);
+        if (!success)
+            remove(packedPath.c_str());
+    }
     
-        // Compress RGBA8888 to RGBA4444
-        uint8_t* input = buffer.data();
-        uint8_t* output = wallpaperData.data();
-        uint8_t r1, g1, b1, a1;
-        uint8_t r2, g2, b2, a2;
-    
-        for (size_t i = 0, j = 0; i < originalDataSize; i += 8, j += 4) {
-            // Read 2 RGBA pixels (8 bytes)
-            r1 = input[i] >> 4;
-            g1 = input[i + 1] >> 4;
-            b1 = input[i + 2] >> 4;
-            a1 = input[i + 3] >> 4;
-    
-            r2 = input[i + 4] >> 4;
-            g2 = input[i + 5] >> 4;
-            b2 = input[i + 6] >> 4;
-            a2 = input[i + 7] >> 4;
-    
-            // Pack them into 4 bytes (2 bytes per pixel)
-            output[j] = (r1 << 4) | g1;
-            output[j + 1] = (b1 << 4) | a1;
-            output[j + 2] = (r2 << 4) | g2;
-            output[j + 3] = (b2 << 4) | a2;
+    
+    // Function to load the RGBA file into memory and modify wallpaperData directly
+    void loadWallpaperFile(const std::string& filePath, s32 width, s32 height) {
+        struct stat source;
+        if (stat(filePath.c_str(), &source) != 0) {
+            wallpaperData.clear();
+            wallpaperGeneration.fetch_add(1, std::memory_order_release);
+            return;
         }
+        
+        wallpaperData.resize(static_cast<size_t>(width) * height * 2); // RGBA4444 uses 2 bytes per pixel
+        
+        const std::string packedPath = getPackedWallpaperPath(filePath);
+        const u32 flags = useWallpaperDithering ? PACKED_WALLPAPER_DITHERED : 0;
+        if (!loadPackedWallpaper(packedPath, source, width, height, flags)) {
+            if (loadLegacyWallpaper(filePath, width))
+                writePackedWallpaper(packedPath, source, width, height, flags);
+            else
+                wallpaperData.clear();
+        }
+        
+        // The pixels may have changed in place, renderer caches key on this instead of the contents
+        wallpaperGeneration.fetch_add(1, std::memory_order_release);
     }
 
 
@@ -1180,6 +1403,7 @@ namespace ult {
     
         // Clear the current wallpaper data
         wallpaperData.clear();
+        wallpaperGeneration.fetch_add(1, std::memory_order_release);
     
         // Reload the wallpaper file
         if (isFileOrDirectory(WALLPAPER_PATH)) {
@@ -1467,9 +1691,14 @@ namespace ult {
     
     // Number of renderer threads to use
     const unsigned numThreads = expandedMemory ? 4 : 0;
+    
+    // Deprecated, see tsl_utils.hpp
+    #pragma GCC diagnostic push
+    #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
     std::vector<std::thread> threads(numThreads);
-    s32 bmpChunkSize = (720 + numThreads - 1) / numThreads;
+    s32 bmpChunkSize = (720 + numThreads - 1) / std::max(numThreads, 1u);
     std::atomic<s32> currentRow;
+    #pragma GCC diagnostic pop
     
     //std::atomic<unsigned int> barrierCounter{0};
     //std::mutex barrierMutex;